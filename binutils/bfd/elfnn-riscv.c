@@ -30,6 +30,8 @@
 #include "bfdlink.h"
 #include "genlink.h"
 #include "elf-bfd.h"
+#include "objalloc.h"
+#include "hashtab.h"
 #include "elfxx-riscv.h"
 #include "elf/riscv.h"
 #include "opcode/riscv.h"
@@ -48,40 +50,26 @@
 #define ELF64_DYNAMIC_INTERPRETER "/lib/ld.so.1"
 #define ELF32_DYNAMIC_INTERPRETER "/lib32/ld.so.1"
 
-/* The RISC-V linker needs to keep track of the number of relocs that it
-   decides to copy as dynamic relocs in check_relocs for each symbol.
-   This is so that it can later discard them if they are found to be
-   unnecessary.  We store the information in a field extending the
-   regular ELF linker hash table.  */
-
-struct riscv_elf_dyn_relocs
-{
-  struct riscv_elf_dyn_relocs *next;
-
-  /* The input section of the reloc.  */
-  asection *sec;
-
-  /* Total number of relocs copied for the input section.  */
-  bfd_size_type count;
-
-  /* Number of pc-relative relocs copied for the input section.  */
-  bfd_size_type pc_count;
-};
-
 /* RISC-V ELF linker hash entry.  */
 
 struct riscv_elf_link_hash_entry
 {
   struct elf_link_hash_entry elf;
 
-  /* Track dynamic relocs copied for this symbol.  */
-  struct riscv_elf_dyn_relocs *dyn_relocs;
+  /* The RISC-V linker needs to keep track of the number of relocs that
+     it decides to copy as dynamic relocs in check_relocs for each
+     symbol.  This is so that it can later discard them if they are
+     found to be unnecessary.  */
+  struct elf_dyn_relocs *dyn_relocs;
 
 #define GOT_UNKNOWN     0
 #define GOT_NORMAL      1
 #define GOT_TLS_GD      2
 #define GOT_TLS_IE      4
 #define GOT_TLS_LE      8
+/* Set for an IE reference that can't be relaxed to LE, so that the
+   symbol keeps its GOT slot.  */
+#define GOT_TLS_NORELAX 16
   char tls_type;
 };
 
@@ -125,6 +113,10 @@ struct riscv_elf_link_hash_table
 
   /* Small local sym to section mapping cache.  */
   struct sym_cache sym_cache;
+
+  /* Hash entries for local STT_GNU_IFUNC symbols.  */
+  htab_t loc_hash_table;
+  void *loc_hash_memory;
 };
 
 
@@ -154,8 +146,8 @@ riscv_elf_append_rela (bfd *abfd, asection *s, Elf_Internal_Rela *rel)
 
 /* PLT/GOT stuff */
 
-#define PLT_HEADER_INSNS 8
-#define PLT_ENTRY_INSNS 4
+#define PLT_HEADER_INSNS (ARCH_SIZE == 32 ? 17 : 20)
+#define PLT_ENTRY_INSNS 3
 #define PLT_HEADER_SIZE (PLT_HEADER_INSNS * 4)
 #define PLT_ENTRY_SIZE (PLT_ENTRY_INSNS * 4)
 
@@ -172,6 +164,15 @@ riscv_elf_got_plt_val (bfd_vma plt_index, struct bfd_link_info *info)
 	 + GOTPLT_HEADER_SIZE + (plt_index * GOT_ENTRY_SIZE);
 }
 
+/* Return the section that holds PLT entries.  Static executables have
+   no .plt, so their STT_GNU_IFUNC symbols get entries in .iplt.  */
+
+static asection *
+riscv_elf_plt_section (struct riscv_elf_link_hash_table *htab)
+{
+  return htab->elf.splt != NULL ? htab->elf.splt : htab->elf.iplt;
+}
+
 #if ARCH_SIZE == 32
 # define MATCH_LREG MATCH_LW
 #else
@@ -183,23 +184,52 @@ riscv_elf_got_plt_val (bfd_vma plt_index, struct bfd_link_info *info)
 static void
 riscv_make_plt0_entry(bfd_vma gotplt_addr, bfd_vma addr, uint32_t *entry)
 {
-  /* auipc  t2, %hi(.got.plt)
-     sub    t1, t1, t0               # shifted .got.plt offset + hdr size + 12
+  /* sub    t1, t1, t0               # PLT entry offset + hdr size + 12
+     addi   t1, t1, -(hdr size + 12) # PLT entry offset
+     slli   t2, t1, 2
+     add    t2, t2, t1
+     slli   t3, t2, 4                # repeated for shifts of 4, 8, 16
+     add    t2, t2, t3               #  (and 32 on RV64): t2 = t1 * 0x55...5
+     slli   t2, t2, 1
+     add    t1, t1, t2               # PLT entry offset / 3
+     slli   t1, t1, log2(PTRSIZE/4)  # shifted .got.plt offset
+     auipc  t2, %hi(.got.plt)
      l[w|d] t3, %lo(.got.plt)(t2)    # _dl_runtime_resolve
-     addi   t1, t1, -(hdr size + 12) # shifted .got.plt offset
      addi   t0, t2, %lo(.got.plt)    # &.got.plt
-     srli   t1, t1, log2(16/PTRSIZE) # .got.plt offset
      l[w|d] t0, PTRSIZE(t0)          # link map
-     jr     t3 */
-
-  entry[0] = RISCV_UTYPE (AUIPC, X_T2, RISCV_PCREL_HIGH_PART (gotplt_addr, addr));
-  entry[1] = RISCV_RTYPE (SUB, X_T1, X_T1, X_T0);
-  entry[2] = RISCV_ITYPE (LREG, X_T3, X_T2, RISCV_PCREL_LOW_PART (gotplt_addr, addr));
-  entry[3] = RISCV_ITYPE (ADDI, X_T1, X_T1, -(PLT_HEADER_SIZE + 12));
-  entry[4] = RISCV_ITYPE (ADDI, X_T0, X_T2, RISCV_PCREL_LOW_PART (gotplt_addr, addr));
-  entry[5] = RISCV_ITYPE (SRLI, X_T1, X_T1, 4 - RISCV_ELF_LOG_WORD_BYTES);
-  entry[6] = RISCV_ITYPE (LREG, X_T0, X_T0, RISCV_ELF_WORD_BYTES);
-  entry[7] = RISCV_ITYPE (JALR, 0, X_T3, 0);
+     jr     t3
+
+     PLT entries are 12 bytes, but _dl_runtime_resolve expects t1 to hold
+     the entry's .got.plt offset, PTRSIZE per entry, as it did when they
+     were 16.  The entry offset is a multiple of 3, so it is divided
+     exactly by multiplying by the inverse of 3 modulo 2^XLEN,
+     0xAA...AB = 1 + 2 * 0x55...5, which is built with shifts and adds
+     because the M extension may be absent.  */
+
+  int i = 0, shift;
+
+  entry[i++] = RISCV_RTYPE (SUB, X_T1, X_T1, X_T0);
+  entry[i++] = RISCV_ITYPE (ADDI, X_T1, X_T1, -(PLT_HEADER_SIZE + 12));
+  entry[i++] = RISCV_ITYPE (SLLI, X_T2, X_T1, 2);
+  entry[i++] = RISCV_RTYPE (ADD, X_T2, X_T2, X_T1);
+  for (shift = 4; shift < ARCH_SIZE; shift *= 2)
+    {
+      entry[i++] = RISCV_ITYPE (SLLI, X_T3, X_T2, shift);
+      entry[i++] = RISCV_RTYPE (ADD, X_T2, X_T2, X_T3);
+    }
+  entry[i++] = RISCV_ITYPE (SLLI, X_T2, X_T2, 1);
+  entry[i++] = RISCV_RTYPE (ADD, X_T1, X_T1, X_T2);
+  if (RISCV_ELF_LOG_WORD_BYTES > 2)
+    entry[i++] = RISCV_ITYPE (SLLI, X_T1, X_T1, RISCV_ELF_LOG_WORD_BYTES - 2);
+
+  addr += i * 4;
+  entry[i++] = RISCV_UTYPE (AUIPC, X_T2, RISCV_PCREL_HIGH_PART (gotplt_addr, addr));
+  entry[i++] = RISCV_ITYPE (LREG, X_T3, X_T2, RISCV_PCREL_LOW_PART (gotplt_addr, addr));
+  entry[i++] = RISCV_ITYPE (ADDI, X_T0, X_T2, RISCV_PCREL_LOW_PART (gotplt_addr, addr));
+  entry[i++] = RISCV_ITYPE (LREG, X_T0, X_T0, RISCV_ELF_WORD_BYTES);
+  entry[i++] = RISCV_ITYPE (JALR, 0, X_T3, 0);
+
+  BFD_ASSERT (i == PLT_HEADER_INSNS);
 }
 
 /* The format of subsequent PLT entries.  */
@@ -209,13 +239,11 @@ riscv_make_plt_entry(bfd_vma got_address, bfd_vma addr, uint32_t *entry)
 {
   /* auipc  t1, %hi(.got.plt entry)
      l[w|d] t0, %lo(.got.plt entry)(t1)
-     jalr   t1, t0
-     nop */
+     jalr   t1, t0 */
 
   entry[0] = RISCV_UTYPE (AUIPC, X_T1, RISCV_PCREL_HIGH_PART (got_address, addr));
   entry[1] = RISCV_ITYPE (LREG,  X_T0, X_T1, RISCV_PCREL_LOW_PART(got_address, addr));
   entry[2] = RISCV_ITYPE (JALR, X_T1, X_T0, 0);
-  entry[3] = RISCV_NOP;
 }
 
 /* Create an entry in an RISC-V ELF linker hash table.  */
@@ -249,6 +277,84 @@ link_hash_newfunc (struct bfd_hash_entry *entry,
   return entry;
 }
 
+/* Compute a hash of a local hash entry.  We use elf_link_hash_entry
+   for local symbol so that we can handle local STT_GNU_IFUNC symbols
+   as global symbol.  We reuse indx and dynstr_index for local symbol
+   hash since they aren't used by global symbols in this backend.  */
+
+static hashval_t
+riscv_elf_local_htab_hash (const void *ptr)
+{
+  struct elf_link_hash_entry *h = (struct elf_link_hash_entry *) ptr;
+  return ELF_LOCAL_SYMBOL_HASH (h->indx, h->dynstr_index);
+}
+
+/* Compare local hash entries.  */
+
+static int
+riscv_elf_local_htab_eq (const void *ptr1, const void *ptr2)
+{
+  struct elf_link_hash_entry *h1 = (struct elf_link_hash_entry *) ptr1;
+  struct elf_link_hash_entry *h2 = (struct elf_link_hash_entry *) ptr2;
+
+  return h1->indx == h2->indx && h1->dynstr_index == h2->dynstr_index;
+}
+
+/* Find and/or create a hash entry for local symbol.  */
+
+static struct elf_link_hash_entry *
+riscv_elf_get_local_sym_hash (struct riscv_elf_link_hash_table *htab,
+			      bfd *abfd, const Elf_Internal_Rela *rel,
+			      bfd_boolean create)
+{
+  struct riscv_elf_link_hash_entry e, *ret;
+  asection *sec = abfd->sections;
+  hashval_t h = ELF_LOCAL_SYMBOL_HASH (sec->id, ELFNN_R_SYM (rel->r_info));
+  void **slot;
+
+  e.elf.indx = sec->id;
+  e.elf.dynstr_index = ELFNN_R_SYM (rel->r_info);
+  slot = htab_find_slot_with_hash (htab->loc_hash_table, &e, h,
+				   create ? INSERT : NO_INSERT);
+
+  if (!slot)
+    return NULL;
+
+  if (*slot)
+    {
+      ret = (struct riscv_elf_link_hash_entry *) *slot;
+      return &ret->elf;
+    }
+
+  ret = (struct riscv_elf_link_hash_entry *)
+	objalloc_alloc ((struct objalloc *) htab->loc_hash_memory,
+			sizeof (struct riscv_elf_link_hash_entry));
+  if (ret)
+    {
+      memset (ret, 0, sizeof (*ret));
+      ret->elf.indx = sec->id;
+      ret->elf.dynstr_index = ELFNN_R_SYM (rel->r_info);
+      ret->elf.dynindx = -1;
+      *slot = ret;
+    }
+  return &ret->elf;
+}
+
+/* Destroy a RISC-V ELF linker hash table.  */
+
+static void
+riscv_elf_link_hash_table_free (bfd *obfd)
+{
+  struct riscv_elf_link_hash_table *htab
+    = (struct riscv_elf_link_hash_table *) obfd->link.hash;
+
+  if (htab->loc_hash_table)
+    htab_delete (htab->loc_hash_table);
+  if (htab->loc_hash_memory)
+    objalloc_free ((struct objalloc *) htab->loc_hash_memory);
+  _bfd_elf_link_hash_table_free (obfd);
+}
+
 /* Create a RISC-V ELF linker hash table.  */
 
 static struct bfd_link_hash_table *
@@ -269,6 +375,18 @@ riscv_elf_link_hash_table_create (bfd *abfd)
       return NULL;
     }
 
+  ret->loc_hash_table = htab_try_create (1024,
+					 riscv_elf_local_htab_hash,
+					 riscv_elf_local_htab_eq,
+					 NULL);
+  ret->loc_hash_memory = objalloc_create ();
+  if (!ret->loc_hash_table || !ret->loc_hash_memory)
+    {
+      riscv_elf_link_hash_table_free (abfd);
+      return NULL;
+    }
+  ret->elf.root.hash_table_free = riscv_elf_link_hash_table_free;
+
   return &ret->elf.root;
 }
 
@@ -389,14 +507,14 @@ riscv_elf_copy_indirect_symbol (struct bfd_link_info *info,
     {
       if (edir->dyn_relocs != NULL)
 	{
-	  struct riscv_elf_dyn_relocs **pp;
-	  struct riscv_elf_dyn_relocs *p;
+	  struct elf_dyn_relocs **pp;
+	  struct elf_dyn_relocs *p;
 
 	  /* Add reloc counts against the indirect sym to the direct sym
 	     list.  Merge any entries against the same section.  */
 	  for (pp = &eind->dyn_relocs; (p = *pp) != NULL; )
 	    {
-	      struct riscv_elf_dyn_relocs *q;
+	      struct elf_dyn_relocs *q;
 
 	      for (q = edir->dyn_relocs; q != NULL; q = q->next)
 		if (q->sec == p->sec)
@@ -484,6 +602,48 @@ bad_static_reloc (bfd *abfd, unsigned r_type, struct elf_link_hash_entry *h)
   bfd_set_error (bfd_error_bad_value);
   return FALSE;
 }
+
+/* Return TRUE if REL, a TLS_GD_HI20 or TLS_GOT_HI20 reloc, heads the
+   code sequence the compiler emits for it, so that an executable can
+   rewrite it for a cheaper access model.  A GD sequence is AUIPC, ADDI,
+   CALL __tls_get_addr; an IE sequence is AUIPC, load.  Either way the
+   low part is the very next instruction.  */
+
+static bfd_boolean
+riscv_elf_tls_sequence_p (bfd *abfd, const Elf_Internal_Rela *rel,
+			  const Elf_Internal_Rela *relend)
+{
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
+  const Elf_Internal_Rela *lo = rel + 1, *call = rel + 2;
+  struct elf_link_hash_entry *h;
+  unsigned long r_symndx;
+
+  if (lo >= relend
+      || ELFNN_R_TYPE (lo->r_info) != R_RISCV_PCREL_LO12_I
+      || lo->r_offset != rel->r_offset + 4)
+    return FALSE;
+
+  if (ELFNN_R_TYPE (rel->r_info) == R_RISCV_TLS_GOT_HI20)
+    return TRUE;
+
+  if (call >= relend
+      || (ELFNN_R_TYPE (call->r_info) != R_RISCV_CALL
+	  && ELFNN_R_TYPE (call->r_info) != R_RISCV_CALL_PLT)
+      || call->r_offset != rel->r_offset + 8)
+    return FALSE;
+
+  r_symndx = ELFNN_R_SYM (call->r_info);
+  if (r_symndx < symtab_hdr->sh_info)
+    return FALSE;
+
+  h = elf_sym_hashes (abfd)[r_symndx - symtab_hdr->sh_info];
+  while (h->root.type == bfd_link_hash_indirect
+	 || h->root.type == bfd_link_hash_warning)
+    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+
+  return strcmp (h->root.root.string, "__tls_get_addr") == 0;
+}
+
 /* Look through the relocs for a section during the first phase, and
    allocate space in the global offset table or procedure linkage
    table.  */
@@ -525,7 +685,30 @@ riscv_elf_check_relocs (bfd *abfd, struct bfd_link_info *info,
 	}
 
       if (r_symndx < symtab_hdr->sh_info)
-	h = NULL;
+	{
+	  /* A local symbol.  */
+	  Elf_Internal_Sym *isym = bfd_sym_from_r_symndx (&htab->sym_cache,
+							  abfd, r_symndx);
+	  if (isym == NULL)
+	    return FALSE;
+
+	  /* Local STT_GNU_IFUNC symbols need a PLT entry just like
+	     global ones, so fake up a hash entry to track it.  */
+	  if (ELF_ST_TYPE (isym->st_info) == STT_GNU_IFUNC)
+	    {
+	      h = riscv_elf_get_local_sym_hash (htab, abfd, rel, TRUE);
+	      if (h == NULL)
+		return FALSE;
+
+	      h->type = STT_GNU_IFUNC;
+	      h->def_regular = 1;
+	      h->ref_regular = 1;
+	      h->forced_local = 1;
+	      h->root.type = bfd_link_hash_defined;
+	    }
+	  else
+	    h = NULL;
+	}
       else
 	{
 	  h = sym_hashes[r_symndx - symtab_hdr->sh_info];
@@ -538,21 +721,66 @@ riscv_elf_check_relocs (bfd *abfd, struct bfd_link_info *info,
 	  h->root.non_ir_ref = 1;
 	}
 
+      if (h != NULL)
+	{
+	  /* Create the ifunc sections here, before the linker maps
+	     input sections to output sections; we may not learn that
+	     H is an STT_GNU_IFUNC symbol until a later input file.  If
+	     none turn up, the sections stay empty and are stripped.  */
+	  switch (r_type)
+	    {
+	    case R_RISCV_32:
+	    case R_RISCV_64:
+	    case R_RISCV_HI20:
+	    case R_RISCV_PCREL_HI20:
+	    case R_RISCV_GOT_HI20:
+	    case R_RISCV_BRANCH:
+	    case R_RISCV_RVC_BRANCH:
+	    case R_RISCV_JAL:
+	    case R_RISCV_RVC_JUMP:
+	    case R_RISCV_CALL:
+	    case R_RISCV_CALL_PLT:
+	      if (!_bfd_elf_create_ifunc_sections (htab->elf.dynobj, info))
+		return FALSE;
+	      /* It is referenced by a non-shared object.  */
+	      h->ref_regular = 1;
+	      break;
+
+	    default:
+	      break;
+	    }
+	}
+
       switch (r_type)
 	{
 	case R_RISCV_TLS_GD_HI20:
-	  if (!riscv_elf_record_got_reference (abfd, info, h, r_symndx)
-	      || !riscv_elf_record_tls_type (abfd, h, r_symndx, GOT_TLS_GD))
-	    return FALSE;
-	  break;
-
 	case R_RISCV_TLS_GOT_HI20:
-	  if (info->shared)
-	    info->flags |= DF_STATIC_TLS;
-	  if (!riscv_elf_record_got_reference (abfd, info, h, r_symndx)
-	      || !riscv_elf_record_tls_type (abfd, h, r_symndx, GOT_TLS_IE))
-	    return FALSE;
-	  break;
+	  {
+	    /* An executable knows its own TLS layout, so GD becomes IE and
+	       a local symbol's access becomes LE.  Whether a global symbol
+	       binds locally isn't known until all input is read, so it is
+	       recorded as IE, and allocate_dynrelocs may drop its slot.  */
+	    const Elf_Internal_Rela *relend = relocs + sec->reloc_count;
+	    bfd_boolean relax = (info->executable
+				 && riscv_elf_tls_sequence_p (abfd, rel, relend));
+	    char tls_type;
+
+	    if (relax && h == NULL)
+	      tls_type = GOT_TLS_LE;
+	    else if (relax)
+	      tls_type = GOT_TLS_IE;
+	    else if (r_type == R_RISCV_TLS_GOT_HI20)
+	      tls_type = GOT_TLS_IE | GOT_TLS_NORELAX;
+	    else
+	      tls_type = GOT_TLS_GD;
+
+	    if (info->shared && r_type == R_RISCV_TLS_GOT_HI20)
+	      info->flags |= DF_STATIC_TLS;
+	    if (!riscv_elf_record_got_reference (abfd, info, h, r_symndx)
+		|| !riscv_elf_record_tls_type (abfd, h, r_symndx, tls_type))
+	      return FALSE;
+	    break;
+	  }
 
 	case R_RISCV_GOT_HI20:
 	  if (!riscv_elf_record_got_reference (abfd, info, h, r_symndx)
@@ -577,10 +805,18 @@ riscv_elf_check_relocs (bfd *abfd, struct bfd_link_info *info,
 	case R_RISCV_CALL:
 	case R_RISCV_JAL:
 	case R_RISCV_BRANCH:
+	case R_RISCV_RVC_BRANCH:
+	case R_RISCV_RVC_JUMP:
 	case R_RISCV_PCREL_HI20:
 	  /* In shared libs, these relocs are known to bind locally.  */
 	  if (info->shared)
-	    break;
+	    {
+	      /* But they must still go through the PLT to reach an
+		 STT_GNU_IFUNC symbol.  */
+	      if (h != NULL && h->type == STT_GNU_IFUNC)
+		h->plt.refcount += 1;
+	      break;
+	    }
 	  goto static_reloc;
 
 	case R_RISCV_TPREL_HI20:
@@ -611,6 +847,14 @@ riscv_elf_check_relocs (bfd *abfd, struct bfd_link_info *info,
 	      /* We may need a .plt entry if the function this reloc
 		 refers to is in a shared lib.  */
 	      h->plt.refcount += 1;
+
+	      /* Taking the address of a function, rather than calling
+		 it, means its canonical address must be the PLT entry.  */
+	      if (r_type == R_RISCV_HI20
+		  || r_type == R_RISCV_PCREL_HI20
+		  || r_type == R_RISCV_32
+		  || r_type == R_RISCV_64)
+		h->pointer_equality_needed = 1;
 	    }
 
 	  /* If we are creating a shared library, and this is a reloc
@@ -647,8 +891,8 @@ riscv_elf_check_relocs (bfd *abfd, struct bfd_link_info *info,
 		  && (h->root.type == bfd_link_hash_defweak
 		      || !h->def_regular)))
 	    {
-	      struct riscv_elf_dyn_relocs *p;
-	      struct riscv_elf_dyn_relocs **head;
+	      struct elf_dyn_relocs *p;
+	      struct elf_dyn_relocs **head;
 
 	      /* When creating a shared object, we must copy these
 		 relocs into the output file.  We create a reloc
@@ -687,14 +931,14 @@ riscv_elf_check_relocs (bfd *abfd, struct bfd_link_info *info,
 		    s = sec;
 
 		  vpp = &elf_section_data (s)->local_dynrel;
-		  head = (struct riscv_elf_dyn_relocs **) vpp;
+		  head = (struct elf_dyn_relocs **) vpp;
 		}
 
 	      p = *head;
 	      if (p == NULL || p->sec != sec)
 		{
 		  bfd_size_type amt = sizeof *p;
-		  p = ((struct riscv_elf_dyn_relocs *)
+		  p = ((struct elf_dyn_relocs *)
 		       bfd_alloc (htab->elf.dynobj, amt));
 		  if (p == NULL)
 		    return FALSE;
@@ -756,6 +1000,7 @@ riscv_elf_gc_sweep_hook (bfd *abfd, struct bfd_link_info *info,
   Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
   struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (abfd);
   bfd_signed_vma *local_got_refcounts = elf_local_got_refcounts (abfd);
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
 
   if (info->relocatable)
     return TRUE;
@@ -768,11 +1013,26 @@ riscv_elf_gc_sweep_hook (bfd *abfd, struct bfd_link_info *info,
       struct elf_link_hash_entry *h = NULL;
 
       r_symndx = ELFNN_R_SYM (rel->r_info);
-      if (r_symndx >= symtab_hdr->sh_info)
+      if (r_symndx < symtab_hdr->sh_info)
+	{
+	  /* A local symbol.  */
+	  Elf_Internal_Sym *isym = bfd_sym_from_r_symndx (&htab->sym_cache,
+							  abfd, r_symndx);
+	  if (isym == NULL)
+	    return FALSE;
+
+	  if (ELF_ST_TYPE (isym->st_info) == STT_GNU_IFUNC)
+	    {
+	      h = riscv_elf_get_local_sym_hash (htab, abfd, rel, FALSE);
+	      if (h == NULL)
+		abort ();
+	    }
+	}
+      else
 	{
 	  struct riscv_elf_link_hash_entry *eh;
-	  struct riscv_elf_dyn_relocs **pp;
-	  struct riscv_elf_dyn_relocs *p;
+	  struct elf_dyn_relocs **pp;
+	  struct elf_dyn_relocs *p;
 
 	  h = sym_hashes[r_symndx - symtab_hdr->sh_info];
 	  while (h->root.type == bfd_link_hash_indirect
@@ -807,16 +1067,22 @@ riscv_elf_gc_sweep_hook (bfd *abfd, struct bfd_link_info *info,
 	  break;
 
 	case R_RISCV_HI20:
-	case R_RISCV_PCREL_HI20:
 	case R_RISCV_COPY:
 	case R_RISCV_JUMP_SLOT:
 	case R_RISCV_RELATIVE:
 	case R_RISCV_64:
 	case R_RISCV_32:
+	  if (info->shared)
+	    break;
+	  /* Fall through.  */
+
+	case R_RISCV_PCREL_HI20:
 	case R_RISCV_BRANCH:
+	case R_RISCV_RVC_BRANCH:
 	case R_RISCV_CALL:
 	case R_RISCV_JAL:
-	  if (info->shared)
+	case R_RISCV_RVC_JUMP:
+	  if (info->shared && (h == NULL || h->type != STT_GNU_IFUNC))
 	    break;
 	  /* Fall through.  */
 
@@ -848,7 +1114,7 @@ riscv_elf_adjust_dynamic_symbol (struct bfd_link_info *info,
 {
   struct riscv_elf_link_hash_table *htab;
   struct riscv_elf_link_hash_entry * eh;
-  struct riscv_elf_dyn_relocs *p;
+  struct elf_dyn_relocs *p;
   bfd *dynobj;
   asection *s;
 
@@ -857,6 +1123,48 @@ riscv_elf_adjust_dynamic_symbol (struct bfd_link_info *info,
 
   dynobj = htab->elf.dynobj;
 
+  /* STT_GNU_IFUNC symbols must go through the PLT.  */
+  if (h->type == STT_GNU_IFUNC)
+    {
+      /* All local STT_GNU_IFUNC references must be treated as local
+	 calls via the local PLT.  */
+      if (h->ref_regular && SYMBOL_CALLS_LOCAL (info, h))
+	{
+	  bfd_size_type pc_count = 0, count = 0;
+	  struct elf_dyn_relocs **pp;
+
+	  eh = (struct riscv_elf_link_hash_entry *) h;
+	  for (pp = &eh->dyn_relocs; (p = *pp) != NULL; )
+	    {
+	      pc_count += p->pc_count;
+	      p->count -= p->pc_count;
+	      p->pc_count = 0;
+	      count += p->count;
+	      if (p->count == 0)
+		*pp = p->next;
+	      else
+		pp = &p->next;
+	    }
+
+	  if (pc_count || count)
+	    {
+	      h->needs_plt = 1;
+	      h->non_got_ref = 1;
+	      if (h->plt.refcount <= 0)
+		h->plt.refcount = 1;
+	      else
+		h->plt.refcount += 1;
+	    }
+	}
+
+      if (h->plt.refcount <= 0)
+	{
+	  h->plt.offset = (bfd_vma) -1;
+	  h->needs_plt = 0;
+	}
+      return TRUE;
+    }
+
   /* Make sure we know what is going on here.  */
   BFD_ASSERT (dynobj != NULL
 	      && (h->needs_plt
@@ -973,7 +1281,7 @@ allocate_dynrelocs (struct elf_link_hash_entry *h, void *inf)
   struct bfd_link_info *info;
   struct riscv_elf_link_hash_table *htab;
   struct riscv_elf_link_hash_entry *eh;
-  struct riscv_elf_dyn_relocs *p;
+  struct elf_dyn_relocs *p;
 
   if (h->root.type == bfd_link_hash_indirect)
     return TRUE;
@@ -982,6 +1290,15 @@ allocate_dynrelocs (struct elf_link_hash_entry *h, void *inf)
   htab = riscv_elf_hash_table (info);
   BFD_ASSERT (htab != NULL);
 
+  /* STT_GNU_IFUNC symbols defined in a regular object always get a
+     PLT entry, in .iplt if this is a static link.  */
+  eh = (struct riscv_elf_link_hash_entry *) h;
+  if (h->type == STT_GNU_IFUNC && h->def_regular)
+    return _bfd_elf_allocate_ifunc_dyn_relocs (info, h, &eh->dyn_relocs,
+					       PLT_ENTRY_SIZE,
+					       PLT_HEADER_SIZE,
+					       GOT_ENTRY_SIZE);
+
   if (htab->elf.dynamic_sections_created
       && h->plt.refcount > 0)
     {
@@ -1036,7 +1353,15 @@ allocate_dynrelocs (struct elf_link_hash_entry *h, void *inf)
       h->needs_plt = 0;
     }
 
-  if (h->got.refcount > 0)
+  /* If every TLS reference to a symbol that binds locally in an
+     executable is IE, they all become LE and need no GOT slot.  */
+  if (h->got.refcount > 0
+      && info->executable
+      && ((riscv_elf_hash_entry (h)->tls_type
+	   & (GOT_TLS_GD | GOT_TLS_IE | GOT_TLS_NORELAX)) == GOT_TLS_IE)
+      && SYMBOL_REFERENCES_LOCAL (info, h))
+    h->got.offset = (bfd_vma) -1;
+  else if (h->got.refcount > 0)
     {
       asection *s;
       bfd_boolean dyn;
@@ -1080,7 +1405,6 @@ allocate_dynrelocs (struct elf_link_hash_entry *h, void *inf)
   else
     h->got.offset = (bfd_vma) -1;
 
-  eh = (struct riscv_elf_link_hash_entry *) h;
   if (eh->dyn_relocs == NULL)
     return TRUE;
 
@@ -1094,7 +1418,7 @@ allocate_dynrelocs (struct elf_link_hash_entry *h, void *inf)
     {
       if (SYMBOL_CALLS_LOCAL (info, h))
 	{
-	  struct riscv_elf_dyn_relocs **pp;
+	  struct elf_dyn_relocs **pp;
 
 	  for (pp = &eh->dyn_relocs; (p = *pp) != NULL; )
 	    {
@@ -1168,13 +1492,31 @@ allocate_dynrelocs (struct elf_link_hash_entry *h, void *inf)
   return TRUE;
 }
 
+/* Allocate space in .plt, .got and associated reloc sections for
+   local STT_GNU_IFUNC symbols.  */
+
+static int
+allocate_local_dynrelocs (void **slot, void *inf)
+{
+  struct elf_link_hash_entry *h = (struct elf_link_hash_entry *) *slot;
+
+  if (h->type != STT_GNU_IFUNC
+      || !h->def_regular
+      || !h->ref_regular
+      || !h->forced_local
+      || h->root.type != bfd_link_hash_defined)
+    abort ();
+
+  return allocate_dynrelocs (h, inf);
+}
+
 /* Find any dynamic relocs that apply to read-only sections.  */
 
 static bfd_boolean
 readonly_dynrelocs (struct elf_link_hash_entry *h, void *inf)
 {
   struct riscv_elf_link_hash_entry *eh;
-  struct riscv_elf_dyn_relocs *p;
+  struct elf_dyn_relocs *p;
 
   eh = (struct riscv_elf_link_hash_entry *) h;
   for (p = eh->dyn_relocs; p != NULL; p = p->next)
@@ -1233,7 +1575,7 @@ riscv_elf_size_dynamic_sections (bfd *output_bfd, struct bfd_link_info *info)
 
       for (s = ibfd->sections; s != NULL; s = s->next)
 	{
-	  struct riscv_elf_dyn_relocs *p;
+	  struct elf_dyn_relocs *p;
 
 	  for (p = elf_section_data (s)->local_dynrel; p != NULL; p = p->next)
 	    {
@@ -1267,7 +1609,8 @@ riscv_elf_size_dynamic_sections (bfd *output_bfd, struct bfd_link_info *info)
       srel = htab->elf.srelgot;
       for (; local_got < end_local_got; ++local_got, ++local_tls_type)
 	{
-	  if (*local_got > 0)
+	  /* Local TLS symbols accessed only as LE need no slot.  */
+	  if (*local_got > 0 && *local_tls_type != GOT_TLS_LE)
 	    {
 	      *local_got = s->size;
 	      s->size += RISCV_ELF_WORD_BYTES;
@@ -1286,6 +1629,9 @@ riscv_elf_size_dynamic_sections (bfd *output_bfd, struct bfd_link_info *info)
      sym dynamic relocs.  */
   elf_link_hash_traverse (&htab->elf, allocate_dynrelocs, info);
 
+  /* Likewise for local STT_GNU_IFUNC symbols.  */
+  htab_traverse (htab->loc_hash_table, allocate_local_dynrelocs, info);
+
   if (htab->elf.sgotplt)
     {
       struct elf_link_hash_entry *got;
@@ -1317,6 +1663,8 @@ riscv_elf_size_dynamic_sections (bfd *output_bfd, struct bfd_link_info *info)
       if (s == htab->elf.splt
 	  || s == htab->elf.sgot
 	  || s == htab->elf.sgotplt
+	  || s == htab->elf.iplt
+	  || s == htab->elf.igotplt
 	  || s == htab->sdynbss)
 	{
 	  /* Strip this section if we don't need it; see the
@@ -1505,6 +1853,35 @@ perform_relocation (const reloc_howto_type *howto,
       value = ENCODE_SBTYPE_IMM (value);
       break;
 
+    case R_RISCV_RVC_BRANCH:
+      if (!VALID_RVC_B_IMM (value))
+	return bfd_reloc_overflow;
+      value = ENCODE_RVC_B_IMM (value);
+      break;
+
+    case R_RISCV_RVC_JUMP:
+      if (!VALID_RVC_J_IMM (value))
+	return bfd_reloc_overflow;
+      value = ENCODE_RVC_J_IMM (value);
+      break;
+
+    case R_RISCV_RVC_LUI:
+      if (RISCV_CONST_HIGH_PART (value) == 0)
+	{
+	  /* Relaxation may have moved the symbol below 0x800, where C.LUI
+	     can no longer reach it because its immediate may not be zero.
+	     Turn it into C.LI rd, 0 instead; the LO12 reloc does the rest.  */
+	  bfd_vma insn = bfd_get_16 (input_bfd, contents + rel->r_offset);
+	  insn = (insn & ~MASK_C_LUI) | MATCH_C_LI;
+	  bfd_put_16 (input_bfd, insn, contents + rel->r_offset);
+	  value = ENCODE_RVC_IMM (0);
+	}
+      else if (!VALID_RVC_LUI_IMM (RISCV_CONST_HIGH_PART (value)))
+	return bfd_reloc_overflow;
+      else
+	value = ENCODE_RVC_LUI_IMM (RISCV_CONST_HIGH_PART (value));
+      break;
+
     case R_RISCV_32:
     case R_RISCV_64:
     case R_RISCV_ADD8:
@@ -1531,11 +1908,16 @@ perform_relocation (const reloc_howto_type *howto,
 }
 
 /* Remember all PC-relative high-part relocs we've encountered to help us
-   later resolve the corresponding low-part relocs.  */
+   later resolve the corresponding low-part relocs.  During relaxation,
+   each high part instead records its reloc and the low-part relocs that
+   consume it, so that the pair can be rewritten together.  */
 
 typedef struct {
   bfd_vma address;
   bfd_vma value;
+  Elf_Internal_Rela *hi_reloc;
+  Elf_Internal_Rela **lo_relocs;
+  unsigned int lo_count;
 } riscv_pcrel_hi_reloc;
 
 typedef struct riscv_pcrel_lo_reloc {
@@ -1568,13 +1950,19 @@ riscv_pcrel_reloc_eq (const void *entry1, const void *entry2)
   return e1->address == e2->address;
 }
 
+static void
+riscv_pcrel_reloc_free (void *entry)
+{
+  riscv_pcrel_hi_reloc *e = entry;
+  free (e->lo_relocs);
+  free (e);
+}
+
 static bfd_boolean
 riscv_init_pcrel_relocs (riscv_pcrel_relocs *p)
 {
-
-  p->lo_relocs = NULL;
   p->hi_relocs = htab_create (1024, riscv_pcrel_reloc_hash,
-			      riscv_pcrel_reloc_eq, free);
+			      riscv_pcrel_reloc_eq, riscv_pcrel_reloc_free);
   return p->hi_relocs != NULL;
 }
 
@@ -1589,15 +1977,36 @@ riscv_free_pcrel_relocs (riscv_pcrel_relocs *p)
       cur = next;
     }
 
-  htab_delete (p->hi_relocs);
+  if (p->hi_relocs != NULL)
+    htab_delete (p->hi_relocs);
 }
 
+/* Return the high-part reloc recorded at ADDR, or NULL if there is none.  */
+
+static riscv_pcrel_hi_reloc *
+riscv_find_pcrel_hi_reloc (riscv_pcrel_relocs *p, bfd_vma addr)
+{
+  riscv_pcrel_hi_reloc search = {addr, 0, NULL, NULL, 0};
+
+  if (p->hi_relocs == NULL)
+    return NULL;
+  return htab_find (p->hi_relocs, &search);
+}
+
+/* Record a high-part reloc at ADDR.  The table is only created once one
+   is seen, since most sections, and all debug sections, have none.  */
+
 static bfd_boolean
 riscv_record_pcrel_hi_reloc (riscv_pcrel_relocs *p, bfd_vma addr, bfd_vma value)
 {
-  riscv_pcrel_hi_reloc entry = {addr, value - addr};
-  riscv_pcrel_hi_reloc **slot =
-    (riscv_pcrel_hi_reloc **) htab_find_slot (p->hi_relocs, &entry, INSERT);
+  riscv_pcrel_hi_reloc entry = {addr, value - addr, NULL, NULL, 0};
+  riscv_pcrel_hi_reloc **slot;
+
+  if (p->hi_relocs == NULL && !riscv_init_pcrel_relocs (p))
+    return FALSE;
+
+  slot = (riscv_pcrel_hi_reloc **) htab_find_slot (p->hi_relocs, &entry,
+						   INSERT);
   BFD_ASSERT (*slot == NULL);
   *slot = (riscv_pcrel_hi_reloc *) bfd_malloc (sizeof (riscv_pcrel_hi_reloc));
   if (*slot == NULL)
@@ -1606,6 +2015,10 @@ riscv_record_pcrel_hi_reloc (riscv_pcrel_relocs *p, bfd_vma addr, bfd_vma value)
   return TRUE;
 }
 
+/* Relocate a low-part reloc against the high part at ADDR.  Low parts
+   almost always follow their high part, so do it now if we can, and
+   otherwise queue it for riscv_resolve_pcrel_lo_relocs.  */
+
 static bfd_boolean
 riscv_record_pcrel_lo_reloc (riscv_pcrel_relocs *p,
 			     asection *input_section,
@@ -1616,7 +2029,16 @@ riscv_record_pcrel_lo_reloc (riscv_pcrel_relocs *p,
 			     const char *name,
 			     bfd_byte *contents)
 {
+  riscv_pcrel_hi_reloc *hi = riscv_find_pcrel_hi_reloc (p, addr);
   riscv_pcrel_lo_reloc *entry;
+
+  if (hi != NULL)
+    {
+      perform_relocation (howto, reloc, hi->value, input_section,
+			  input_section->owner, contents);
+      return TRUE;
+    }
+
   entry = (riscv_pcrel_lo_reloc *) bfd_malloc (sizeof (riscv_pcrel_lo_reloc));
   if (entry == NULL)
     return FALSE;
@@ -1633,8 +2055,7 @@ riscv_resolve_pcrel_lo_relocs (riscv_pcrel_relocs *p)
   for (r = p->lo_relocs; r != NULL; r = r->next)
     {
       bfd *input_bfd = r->input_section->owner;
-      riscv_pcrel_hi_reloc search = {r->addr, 0};
-      riscv_pcrel_hi_reloc *entry = htab_find (p->hi_relocs, &search);
+      riscv_pcrel_hi_reloc *entry = riscv_find_pcrel_hi_reloc (p, r->addr);
       if (entry == NULL)
 	return ((*r->info->callbacks->reloc_overflow)
 		 (r->info, NULL, r->name, r->howto->name, (bfd_vma) 0,
@@ -1647,6 +2068,94 @@ riscv_resolve_pcrel_lo_relocs (riscv_pcrel_relocs *p)
   return TRUE;
 }
 
+/* Rewrite the TLS sequence headed by REL, which riscv_elf_tls_sequence_p
+   accepted, for the IE model, or for LE if LE is set, in which case VALUE
+   is the symbol's tp offset.  Return FALSE if the instructions aren't
+   the ones the relocs promise.  */
+
+static bfd_boolean
+riscv_elf_tls_relax (bfd *abfd, bfd_byte *contents, Elf_Internal_Rela *rel,
+		     bfd_boolean le, bfd_vma value)
+{
+  bfd_byte *loc = contents + rel->r_offset;
+  bfd_vma auipc = bfd_get_32 (abfd, loc);
+  bfd_vma lo = bfd_get_32 (abfd, loc + 4);
+  bfd_vma regs = (OP_MASK_RD << OP_SH_RD) | (OP_MASK_RS1 << OP_SH_RS1);
+  bfd_vma match_load = ARCH_SIZE == 64 ? MATCH_LD : MATCH_LW;
+  bfd_vma rd = (auipc >> OP_SH_RD) & OP_MASK_RD;
+
+  if (((lo >> OP_SH_RS1) & OP_MASK_RS1) != rd)
+    return FALSE;
+
+  if (ELFNN_R_TYPE (rel->r_info) == R_RISCV_TLS_GD_HI20)
+    {
+      /* GD to IE: load the tp offset from the GOT instead of forming
+	 the argument to __tls_get_addr, then add tp in place of the call.  */
+      if (rd != X_A0
+	  || ((lo >> OP_SH_RD) & OP_MASK_RD) != X_A0
+	  || (lo & MASK_ADDI) != MATCH_ADDI)
+	return FALSE;
+
+      lo = (lo & regs) | match_load;
+      bfd_put_32 (abfd, RISCV_RTYPE (ADD, X_A0, X_A0, X_TP), loc + 8);
+      bfd_put_32 (abfd, RISCV_NOP, loc + 12);
+      rel[2].r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+    }
+  else if ((lo & MASK_LD) != match_load)
+    return FALSE;
+
+  if (le)
+    {
+      /* IE to LE: materialize the tp offset instead of loading it.  */
+      auipc = RISCV_UTYPE (LUI, rd, RISCV_CONST_HIGH_PART (value));
+      lo = (lo & regs) | MATCH_ADDI | ENCODE_ITYPE_IMM (value);
+      bfd_put_32 (abfd, auipc, loc);
+      rel[1].r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+    }
+
+  bfd_put_32 (abfd, lo, loc + 4);
+  return TRUE;
+}
+
+/* Initialize the GOT entry of local symbol R_SYMNDX, whose value is
+   RELOCATION, unless that has already been done, and return the entry's
+   offset.  The offset must always be a multiple of 4 or 8, so the least
+   significant bit of LOCAL_GOT_OFFSETS[R_SYMNDX] records whether we have
+   already processed this entry.  */
+
+static bfd_vma
+riscv_elf_init_local_got (bfd *output_bfd, struct bfd_link_info *info,
+			  bfd_vma *local_got_offsets,
+			  unsigned long r_symndx, bfd_vma relocation)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  bfd_vma off = local_got_offsets[r_symndx];
+
+  if ((off & 1) != 0)
+    return off & ~1;
+
+  if (info->shared)
+    {
+      asection *s;
+      Elf_Internal_Rela outrel;
+
+      /* We need to generate a R_RISCV_RELATIVE reloc
+	 for the dynamic linker.  */
+      s = htab->elf.srelgot;
+      BFD_ASSERT (s != NULL);
+
+      outrel.r_offset = sec_addr (htab->elf.sgot) + off;
+      outrel.r_info = ELFNN_R_INFO (0, R_RISCV_RELATIVE);
+      outrel.r_addend = relocation;
+      relocation = 0;
+      riscv_elf_append_rela (output_bfd, s, &outrel);
+    }
+
+  bfd_put_NN (output_bfd, relocation, htab->elf.sgot->contents + off);
+  local_got_offsets[r_symndx] |= 1;
+  return off;
+}
+
 /* Relocate a RISC-V ELF section.
 
    The RELOCATE_SECTION function is called by the new ELF backend linker
@@ -1684,7 +2193,7 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 {
   Elf_Internal_Rela *rel;
   Elf_Internal_Rela *relend;
-  riscv_pcrel_relocs pcrel_relocs;
+  riscv_pcrel_relocs pcrel_relocs = {NULL, NULL};
   bfd_boolean ret = FALSE;
   asection *sreloc = elf_section_data (input_section)->sreloc;
   struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
@@ -1692,9 +2201,6 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
   struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (input_bfd);
   bfd_vma *local_got_offsets = elf_local_got_offsets (input_bfd);
 
-  if (!riscv_init_pcrel_relocs (&pcrel_relocs))
-    return FALSE;
-
   relend = relocs + input_section->reloc_count;
   for (rel = relocs; rel < relend; rel++)
     {
@@ -1726,6 +2232,19 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	  sym = local_syms + r_symndx;
 	  sec = local_sections[r_symndx];
 	  relocation = _bfd_elf_rela_local_sym (output_bfd, sym, &sec, rel);
+
+	  /* Relocate against local STT_GNU_IFUNC symbol.  */
+	  if (!info->relocatable
+	      && ELF_ST_TYPE (sym->st_info) == STT_GNU_IFUNC)
+	    {
+	      h = riscv_elf_get_local_sym_hash (htab, input_bfd, rel, FALSE);
+	      if (h == NULL)
+		abort ();
+
+	      /* Set STT_GNU_IFUNC symbol value.  */
+	      h->root.u.def.value = sym->st_value;
+	      h->root.u.def.section = sec;
+	    }
 	}
       else
 	{
@@ -1754,7 +2273,7 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
       if (info->relocatable)
 	continue;
 
-      if (h != NULL)
+      if (h != NULL && h->root.root.string != NULL)
 	name = h->root.root.string;
       else
 	{
@@ -1764,6 +2283,114 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	    name = bfd_section_name (input_bfd, sec);
 	}
 
+      /* References to STT_GNU_IFUNC symbols must go through the PLT.
+	 Non-allocated sections, such as debug info, get no dynamic
+	 relocs, so they just see the resolver's address.  */
+      if (h != NULL
+	  && h->type == STT_GNU_IFUNC
+	  && h->def_regular
+	  && (input_section->flags & SEC_ALLOC) != 0)
+	{
+	  asection *base_got;
+
+	  if (h->plt.offset == MINUS_ONE)
+	    abort ();
+
+	  relocation = sec_addr (riscv_elf_plt_section (htab)) + h->plt.offset;
+
+	  switch (r_type)
+	    {
+	    case R_RISCV_BRANCH:
+	    case R_RISCV_RVC_BRANCH:
+	    case R_RISCV_JAL:
+	    case R_RISCV_RVC_JUMP:
+	    case R_RISCV_CALL:
+	    case R_RISCV_CALL_PLT:
+	    case R_RISCV_HI20:
+	    case R_RISCV_PCREL_HI20:
+	      /* These just refer to the PLT entry.  */
+	      break;
+
+	    case R_RISCV_NN:
+	      if (rel->r_addend != 0)
+		{
+		  (*_bfd_error_handler)
+		    (_("%B: relocation %s against STT_GNU_IFUNC symbol `%s' has non-zero addend: %d"),
+		     input_bfd, howto->name, name, (int) rel->r_addend);
+		  bfd_set_error (bfd_error_bad_value);
+		  goto out;
+		}
+
+	      /* A shared object needs a dynamic reloc to find the real
+		 function address; an executable uses the PLT entry as
+		 the canonical address.  */
+	      if (info->shared && h->non_got_ref)
+		{
+		  Elf_Internal_Rela outrel;
+
+		  outrel.r_offset =
+		    _bfd_elf_section_offset (output_bfd, info, input_section,
+					     rel->r_offset);
+		  if (outrel.r_offset >= (bfd_vma) -2)
+		    abort ();
+		  outrel.r_offset += sec_addr (input_section);
+
+		  if (h->dynindx == -1 || h->forced_local || info->executable)
+		    {
+		      /* This symbol is resolved locally.  */
+		      outrel.r_info = ELFNN_R_INFO (0, R_RISCV_IRELATIVE);
+		      outrel.r_addend = (h->root.u.def.value
+					 + sec_addr (h->root.u.def.section));
+		    }
+		  else
+		    {
+		      outrel.r_info = ELFNN_R_INFO (h->dynindx, r_type);
+		      outrel.r_addend = 0;
+		    }
+
+		  riscv_elf_append_rela (output_bfd, htab->elf.irelifunc,
+					 &outrel);
+		  continue;
+		}
+	      break;
+
+	    case R_RISCV_GOT_HI20:
+	      base_got = htab->elf.sgot;
+	      off = h->got.offset;
+
+	      /* Unless we need pointer equality, which gets a .got entry
+		 holding the PLT address, use the .got.plt entry that
+		 holds the real function address.  */
+	      if (off == MINUS_ONE)
+		{
+		  if (htab->elf.splt != NULL)
+		    {
+		      base_got = htab->elf.sgotplt;
+		      off = GOTPLT_HEADER_SIZE
+			    + ((h->plt.offset - PLT_HEADER_SIZE)
+			       / PLT_ENTRY_SIZE) * GOT_ENTRY_SIZE;
+		    }
+		  else
+		    {
+		      base_got = htab->elf.igotplt;
+		      off = (h->plt.offset / PLT_ENTRY_SIZE) * GOT_ENTRY_SIZE;
+		    }
+		}
+
+	      relocation = sec_addr (base_got) + off;
+	      if (!riscv_record_pcrel_hi_reloc (&pcrel_relocs, pc, relocation))
+		r = bfd_reloc_overflow;
+	      goto do_relocation;
+
+	    default:
+	      (*_bfd_error_handler)
+		(_("%B: relocation %s against STT_GNU_IFUNC symbol `%s' isn't handled by %s"),
+		 input_bfd, howto->name, name, __FUNCTION__);
+	      bfd_set_error (bfd_error_bad_value);
+	      goto out;
+	    }
+	}
+
       switch (r_type)
 	{
 	case R_RISCV_NONE:
@@ -1775,7 +2402,9 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	  continue;
 
 	case R_RISCV_BRANCH:
+	case R_RISCV_RVC_BRANCH:
 	case R_RISCV_HI20:
+	case R_RISCV_RVC_LUI:
 	  /* These require no special handling beyond perform_relocation.  */
 	  break;
 
@@ -1821,37 +2450,9 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	      BFD_ASSERT (local_got_offsets != NULL
 			  && local_got_offsets[r_symndx] != (bfd_vma) -1);
 
-	      off = local_got_offsets[r_symndx];
-
-	      /* The offset must always be a multiple of 8 on 64-bit.
-		 We use the least significant bit to record
-		 whether we have already processed this entry.  */
-	      if ((off & 1) != 0)
-		off &= ~1;
-	      else
-		{
-		  if (info->shared)
-		    {
-		      asection *s;
-		      Elf_Internal_Rela outrel;
-
-		      /* We need to generate a R_RISCV_RELATIVE reloc
-			 for the dynamic linker.  */
-		      s = htab->elf.srelgot;
-		      BFD_ASSERT (s != NULL);
-
-		      outrel.r_offset = sec_addr (htab->elf.sgot) + off;
-		      outrel.r_info =
-			ELFNN_R_INFO (0, R_RISCV_RELATIVE);
-		      outrel.r_addend = relocation;
-		      relocation = 0;
-		      riscv_elf_append_rela (output_bfd, s, &outrel);
-		    }
-
-		  bfd_put_NN (output_bfd, relocation,
-			      htab->elf.sgot->contents + off);
-		  local_got_offsets[r_symndx] |= 1;
-		}
+	      off = riscv_elf_init_local_got (output_bfd, info,
+					      local_got_offsets, r_symndx,
+					      relocation);
 	    }
 	  relocation = sec_addr (htab->elf.sgot) + off;
 	  if (!riscv_record_pcrel_hi_reloc (&pcrel_relocs, pc, relocation))
@@ -1883,6 +2484,7 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	case R_RISCV_CALL_PLT:
 	case R_RISCV_CALL:
 	case R_RISCV_JAL:
+	case R_RISCV_RVC_JUMP:
 	  if (info->shared && h != NULL && h->plt.offset != MINUS_ONE)
 	    {
 	      /* Refer to the PLT entry.  */
@@ -1912,7 +2514,15 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	case R_RISCV_LO12_S:
 	  {
 	    bfd_vma gp = riscv_global_pointer_value (info);
-	    bfd_boolean x0_base = VALID_ITYPE_IMM (relocation + rel->r_addend);
+	    bfd_boolean x0_base;
+
+	    /* An absolute or link-time gp-relative base is only valid
+	       when the output will not be relocated, which excludes
+	       PIEs as well as shared objects.  */
+	    if (info->shared)
+	      break;
+
+	    x0_base = VALID_ITYPE_IMM (relocation + rel->r_addend);
 	    if (x0_base || VALID_ITYPE_IMM (relocation + rel->r_addend - gp))
 	      {
 		/* We can use x0 or gp as the base register.  */
@@ -1929,6 +2539,15 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	  }
 
 	case R_RISCV_PCREL_HI20:
+	  /* This may be a relaxed GOT_HI20, in which case the GOT entry
+	     it no longer loads must still be initialized.  */
+	  if (h == NULL
+	      && local_got_offsets != NULL
+	      && local_got_offsets[r_symndx] != (bfd_vma) -1
+	      && (_bfd_riscv_elf_local_got_tls_type (input_bfd)[r_symndx]
+		  == GOT_NORMAL))
+	    riscv_elf_init_local_got (output_bfd, info, local_got_offsets,
+				      r_symndx, relocation);
 	  if (!riscv_record_pcrel_hi_reloc (&pcrel_relocs, pc,
 					    relocation + rel->r_addend))
 	    r = bfd_reloc_overflow;
@@ -2009,6 +2628,28 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	  /* Fall through.  */
 
 	case R_RISCV_TLS_GD_HI20:
+	  /* In an executable, GD becomes IE, and IE becomes LE if the
+	     symbol has no GOT slot; see riscv_elf_check_relocs.  */
+	  if (info->executable
+	      && riscv_elf_tls_sequence_p (input_bfd, rel, relend))
+	    {
+	      bfd_boolean le = h == NULL || h->got.offset == (bfd_vma) -1;
+	      bfd_vma value = tpoff (info, relocation) + rel->r_addend;
+
+	      if (!riscv_elf_tls_relax (input_bfd, contents, rel, le, value))
+		{
+		  (*_bfd_error_handler)
+		    (_("%B(%A+0x%lx): unexpected instruction sequence for %s relocation against `%s'"),
+		     input_bfd, input_section, (long) rel->r_offset,
+		     howto->name, name);
+		  bfd_set_error (bfd_error_bad_value);
+		  goto out;
+		}
+	      if (le)
+		continue;
+	      is_ie = TRUE;
+	    }
+
 	  if (h != NULL)
 	    {
 	      off = h->got.offset;
@@ -2137,6 +2778,7 @@ riscv_elf_relocate_section (bfd *output_bfd, struct bfd_link_info *info,
 	  r = bfd_reloc_notsupported;
 	}
 
+    do_relocation:
       /* Dynamic relocs are not propagated for SEC_DEBUGGING sections
 	 because such sections are not SEC_ALLOC and thus ld.so will
 	 not process them.  */
@@ -2225,20 +2867,39 @@ riscv_elf_finish_dynamic_symbol (bfd *output_bfd,
       bfd_vma i, header_address, plt_idx, got_address;
       uint32_t plt_entry[PLT_ENTRY_INSNS];
       Elf_Internal_Rela rela;
+      asection *plt, *gotplt, *relplt;
 
-      BFD_ASSERT (h->dynindx != -1);
-
-      /* Calculate the address of the PLT header.  */
-      header_address = sec_addr (htab->elf.splt);
+      /* Static executables put STT_GNU_IFUNC symbols in .iplt, which
+	 has no header, and its .got.plt counterpart, which has no
+	 reserved entries.  */
+      if (htab->elf.splt != NULL)
+	{
+	  plt = htab->elf.splt;
+	  gotplt = htab->elf.sgotplt;
+	  relplt = htab->elf.srelplt;
+	  plt_idx = (h->plt.offset - PLT_HEADER_SIZE) / PLT_ENTRY_SIZE;
+	  got_address = riscv_elf_got_plt_val (plt_idx, info);
+	}
+      else
+	{
+	  plt = htab->elf.iplt;
+	  gotplt = htab->elf.igotplt;
+	  relplt = htab->elf.irelplt;
+	  plt_idx = h->plt.offset / PLT_ENTRY_SIZE;
+	  got_address = sec_addr (gotplt) + plt_idx * GOT_ENTRY_SIZE;
+	}
 
-      /* Calculate the index of the entry.  */
-      plt_idx = (h->plt.offset - PLT_HEADER_SIZE) / PLT_ENTRY_SIZE;
+      /* Only STT_GNU_IFUNC symbols may have a PLT entry without being
+	 dynamic.  */
+      BFD_ASSERT (plt != NULL && gotplt != NULL && relplt != NULL);
+      BFD_ASSERT (h->dynindx != -1
+		  || (h->type == STT_GNU_IFUNC && h->def_regular));
 
-      /* Calculate the address of the .got.plt entry.  */
-      got_address = riscv_elf_got_plt_val (plt_idx, info);
+      /* Calculate the address of the PLT header.  */
+      header_address = sec_addr (plt);
 
       /* Find out where the .plt entry should go.  */
-      loc = htab->elf.splt->contents + h->plt.offset;
+      loc = plt->contents + h->plt.offset;
 
       /* Fill in the PLT entry itself.  */
       riscv_make_plt_entry (got_address, header_address + h->plt.offset,
@@ -2247,16 +2908,31 @@ riscv_elf_finish_dynamic_symbol (bfd *output_bfd,
 	bfd_put_32 (output_bfd, plt_entry[i], loc + 4*i);
 
       /* Fill in the initial value of the .got.plt entry.  */
-      loc = htab->elf.sgotplt->contents
-	    + (got_address - sec_addr (htab->elf.sgotplt));
-      bfd_put_NN (output_bfd, sec_addr (htab->elf.splt), loc);
+      loc = gotplt->contents + (got_address - sec_addr (gotplt));
+      bfd_put_NN (output_bfd, sec_addr (plt), loc);
 
-      /* Fill in the entry in the .rela.plt section.  */
+      /* Fill in the entry in the .rela.plt section.  An STT_GNU_IFUNC
+	 symbol that binds locally is resolved by calling its resolver,
+	 whose address is the symbol's value.  */
       rela.r_offset = got_address;
-      rela.r_addend = 0;
-      rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_JUMP_SLOT);
+      if (h->type == STT_GNU_IFUNC
+	  && h->def_regular
+	  && (h->dynindx == -1
+	      || h->forced_local
+	      || info->executable
+	      || SYMBOLIC_BIND (info, h)))
+	{
+	  rela.r_info = ELFNN_R_INFO (0, R_RISCV_IRELATIVE);
+	  rela.r_addend = (h->root.u.def.value
+			   + sec_addr (h->root.u.def.section));
+	}
+      else
+	{
+	  rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_JUMP_SLOT);
+	  rela.r_addend = 0;
+	}
 
-      loc = htab->elf.srelplt->contents + plt_idx * sizeof (ElfNN_External_Rela);
+      loc = relplt->contents + plt_idx * sizeof (ElfNN_External_Rela);
       bed->s->swap_reloca_out (output_bfd, &rela, loc);
 
       if (!h->def_regular)
@@ -2288,14 +2964,33 @@ riscv_elf_finish_dynamic_symbol (bfd *output_bfd,
 
       rela.r_offset = sec_addr (sgot) + (h->got.offset &~ (bfd_vma) 1);
 
+      /* An STT_GNU_IFUNC symbol only gets a .got entry when its
+	 address is taken.  Executables load it with the PLT entry,
+	 which is the symbol's canonical address; shared objects ask
+	 the dynamic linker for the resolved function.  */
+      if (h->type == STT_GNU_IFUNC && h->def_regular)
+	{
+	  if (!info->shared)
+	    {
+	      bfd_put_NN (output_bfd,
+			  sec_addr (riscv_elf_plt_section (htab))
+			  + h->plt.offset,
+			  sgot->contents + h->got.offset);
+	      return TRUE;
+	    }
+
+	  BFD_ASSERT (h->dynindx != -1);
+	  rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_NN);
+	  rela.r_addend = 0;
+	}
       /* If this is a -Bsymbolic link, and the symbol is defined
 	 locally, we just want to emit a RELATIVE reloc.  Likewise if
 	 the symbol was forced to be local because of a version file.
 	 The entry in the global offset table will already have been
 	 initialized in the relocate_section function.  */
-      if (info->shared
-	  && (info->symbolic || h->dynindx == -1)
-	  && h->def_regular)
+      else if (info->shared
+	       && (info->symbolic || h->dynindx == -1)
+	       && h->def_regular)
 	{
 	  asection *sec = h->root.u.def.section;
 	  rela.r_info = ELFNN_R_INFO (0, R_RISCV_RELATIVE);
@@ -2336,6 +3031,17 @@ riscv_elf_finish_dynamic_symbol (bfd *output_bfd,
   return TRUE;
 }
 
+/* Finish up local STT_GNU_IFUNC symbol handling.  */
+
+static int
+riscv_elf_finish_local_dynamic_symbol (void **slot, void *inf)
+{
+  struct elf_link_hash_entry *h = (struct elf_link_hash_entry *) *slot;
+  struct bfd_link_info *info = (struct bfd_link_info *) inf;
+
+  return riscv_elf_finish_dynamic_symbol (info->output_bfd, info, h, NULL);
+}
+
 /* Finish up the dynamic sections.  */
 
 static bfd_boolean
@@ -2457,6 +3163,10 @@ riscv_elf_finish_dynamic_sections (bfd *output_bfd,
 	GOT_ENTRY_SIZE;
     }
 
+  /* Fill in PLT entries for local STT_GNU_IFUNC symbols.  */
+  htab_traverse (htab->loc_hash_table,
+		 riscv_elf_finish_local_dynamic_symbol, info);
+
   return TRUE;
 }
 
@@ -2483,6 +3193,8 @@ riscv_reloc_type_class (const struct bfd_link_info *info ATTRIBUTE_UNUSED,
       return reloc_class_plt;
     case R_RISCV_COPY:
       return reloc_class_copy;
+    case R_RISCV_IRELATIVE:
+      return reloc_class_ifunc;
     default:
       return reloc_class_normal;
     }
@@ -2556,6 +3268,11 @@ _bfd_riscv_elf_merge_private_bfd_data (bfd *ibfd, bfd *obfd)
       goto fail;
     }
 
+  /* Allow linking RVC and non-RVC, and keep the RVC flag.  */
+  elf_elfheader (obfd)->e_flags |= new_flags & EF_RISCV_RVC;
+  new_flags &= ~EF_RISCV_RVC;
+  old_flags &= ~EF_RISCV_RVC;
+
   /* Warn about any other mismatches.  */
   if (new_flags != old_flags)
     {
@@ -2580,29 +3297,146 @@ fail:
   return FALSE;
 }
 
-/* Delete some bytes from a section while relaxing.  */
+/* Deleting bytes from a section while relaxing is deferred: each relaxation
+   records the range it wants removed, in terms of the section's offsets
+   before this relaxation pass, and the section is compacted once all of its
+   relocs have been examined.  The list is kept sorted by address, and each
+   entry records the total number of bytes deleted up to and including it,
+   so it doubles as a prefix-sum map from old offsets to new ones.  */
+
+typedef struct
+{
+  bfd_vma addr;
+  bfd_vma count;
+  bfd_vma cumulative;
+} riscv_relax_deletion;
+
+typedef struct
+{
+  riscv_relax_deletion *entries;
+  size_t count;
+  size_t alloc;
+} riscv_relax_deletions;
+
+/* Return the number of bytes scheduled for deletion strictly below
+   OFFSET.  */
+
+static bfd_vma
+riscv_relax_deleted_before (const riscv_relax_deletions *del, bfd_vma offset)
+{
+  size_t lo = 0, hi = del->count;
+
+  /* Relocs are usually examined in address order, so try the last
+     entry before searching.  */
+  if (hi == 0)
+    return 0;
+  if (del->entries[hi - 1].addr < offset)
+    return del->entries[hi - 1].cumulative;
+
+  while (lo < hi)
+    {
+      size_t mid = (lo + hi) / 2;
+      if (del->entries[mid].addr < offset)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  return lo == 0 ? 0 : del->entries[lo - 1].cumulative;
+}
+
+/* Map OFFSET from the pre-relaxation layout of the section to the layout
+   it will have once the pending deletions are applied.  */
+
+static bfd_vma
+riscv_relax_map_offset (const riscv_relax_deletions *del, bfd_vma offset)
+{
+  return offset - riscv_relax_deleted_before (del, offset);
+}
+
+/* Schedule COUNT bytes at ADDR for deletion.  */
 
 static bfd_boolean
-riscv_relax_delete_bytes (bfd *abfd, asection *sec, bfd_vma addr, size_t count)
+riscv_relax_delete_bytes (riscv_relax_deletions *del, bfd_vma addr,
+			  size_t count)
+{
+  size_t i;
+
+  if (count == 0)
+    return TRUE;
+
+  if (del->count == del->alloc)
+    {
+      size_t alloc = del->alloc ? del->alloc * 2 : 64;
+      riscv_relax_deletion *entries =
+	bfd_realloc (del->entries, alloc * sizeof (riscv_relax_deletion));
+      if (entries == NULL)
+	return FALSE;
+      del->entries = entries;
+      del->alloc = alloc;
+    }
+
+  /* Find the insertion point; this is almost always the end.  */
+  for (i = del->count; i > 0 && del->entries[i - 1].addr > addr; i--)
+    ;
+
+  if (i > 0 && del->entries[i - 1].addr == addr)
+    del->entries[--i].count += count;
+  else
+    {
+      memmove (del->entries + i + 1, del->entries + i,
+	       (del->count - i) * sizeof (riscv_relax_deletion));
+      del->entries[i].addr = addr;
+      del->entries[i].count = count;
+      del->count++;
+    }
+
+  /* Recompute the prefix sums from the point of insertion.  */
+  for (; i < del->count; i++)
+    del->entries[i].cumulative = del->entries[i].count
+      + (i == 0 ? 0 : del->entries[i - 1].cumulative);
+
+  return TRUE;
+}
+
+/* Apply all of the deletions scheduled for SEC in a single pass over its
+   contents, relocs and symbols.  */
+
+static void
+riscv_relax_apply_deletions (bfd *abfd, asection *sec,
+			     riscv_relax_deletions *del)
 {
   unsigned int i, symcount;
   bfd_vma toaddr = sec->size;
+  bfd_vma src, dst;
   struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (abfd);
   Elf_Internal_Shdr *symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
   unsigned int sec_shndx = _bfd_elf_section_from_bfd_section (abfd, sec);
   struct bfd_elf_section_data *data = elf_section_data (sec);
   bfd_byte *contents = data->this_hdr.contents;
 
-  /* Actually delete the bytes.  */
-  sec->size -= count;
-  memmove (contents + addr, contents + addr + count, toaddr - addr - count);
+  if (del->count == 0)
+    return;
+
+  /* Actually delete the bytes, sliding each surviving run down once.  */
+  for (i = 0, src = dst = 0; i <= del->count; i++)
+    {
+      bfd_vma end = i < del->count ? del->entries[i].addr : toaddr;
+      if (dst != src)
+	memmove (contents + dst, contents + src, end - src);
+      dst += end - src;
+      if (i < del->count)
+	src = end + del->entries[i].count;
+    }
+  sec->size = dst;
 
   /* Adjust the location of all of the relocs.  Note that we need not
      adjust the addends, since all PC-relative references must be against
      symbols, which we will adjust below.  */
   for (i = 0; i < sec->reloc_count; i++)
-    if (data->relocs[i].r_offset > addr && data->relocs[i].r_offset < toaddr)
-      data->relocs[i].r_offset -= count;
+    if (data->relocs[i].r_offset < toaddr)
+      data->relocs[i].r_offset =
+	riscv_relax_map_offset (del, data->relocs[i].r_offset);
 
   /* Adjust the local symbols defined in this section.  */
   for (i = 0; i < symtab_hdr->sh_info; i++)
@@ -2610,18 +3444,19 @@ riscv_relax_delete_bytes (bfd *abfd, asection *sec, bfd_vma addr, size_t count)
       Elf_Internal_Sym *sym = (Elf_Internal_Sym *) symtab_hdr->contents + i;
       if (sym->st_shndx == sec_shndx)
 	{
-	  /* If the symbol is in the range of memory we just moved, we
-	     have to adjust its value.  */
-	  if (sym->st_value > addr && sym->st_value <= toaddr)
-	    sym->st_value -= count;
-
-	  /* If the symbol *spans* the bytes we just deleted (i.e. its
-	     *end* is in the moved bytes but its *start* isn't), then we
-	     must adjust its size.  */
-	  if (sym->st_value <= addr
-	      && sym->st_value + sym->st_size > addr
-	      && sym->st_value + sym->st_size <= toaddr)
-	    sym->st_size -= count;
+	  bfd_vma start = sym->st_value;
+	  bfd_vma end = sym->st_value + sym->st_size;
+
+	  /* If the symbol is in the range of memory we moved, we have to
+	     adjust its value.  */
+	  if (start <= toaddr)
+	    sym->st_value = riscv_relax_map_offset (del, start);
+
+	  /* If the symbol *spans* any of the bytes we deleted, we must
+	     adjust its size.  */
+	  if (end <= toaddr)
+	    sym->st_size -= (riscv_relax_deleted_before (del, end)
+			     - riscv_relax_deleted_before (del, start));
 	}
     }
 
@@ -2637,20 +3472,21 @@ riscv_relax_delete_bytes (bfd *abfd, asection *sec, bfd_vma addr, size_t count)
 	   || sym_hash->root.type == bfd_link_hash_defweak)
 	  && sym_hash->root.u.def.section == sec)
 	{
+	  bfd_vma start = sym_hash->root.u.def.value;
+	  bfd_vma end = start + sym_hash->size;
+
 	  /* As above, adjust the value if needed.  */
-	  if (sym_hash->root.u.def.value > addr
-	      && sym_hash->root.u.def.value <= toaddr)
-	    sym_hash->root.u.def.value -= count;
+	  if (start <= toaddr)
+	    sym_hash->root.u.def.value = riscv_relax_map_offset (del, start);
 
 	  /* As above, adjust the size if needed.  */
-	  if (sym_hash->root.u.def.value <= addr
-	      && sym_hash->root.u.def.value + sym_hash->size > addr
-	      && sym_hash->root.u.def.value + sym_hash->size <= toaddr)
-	    sym_hash->size -= count;
+	  if (end <= toaddr)
+	    sym_hash->size -= (riscv_relax_deleted_before (del, end)
+			       - riscv_relax_deleted_before (del, start));
 	}
     }
 
-  return TRUE;
+  del->count = 0;
 }
 
 /* Relax AUIPC + JALR into JAL.  */
@@ -2660,13 +3496,17 @@ _bfd_riscv_relax_call (bfd *abfd, asection *sec,
 		       struct bfd_link_info *link_info,
 		       Elf_Internal_Rela *rel,
 		       bfd_vma symval,
+		       riscv_pcrel_relocs *pcrel_relocs ATTRIBUTE_UNUSED,
+		       riscv_relax_deletions *del,
 		       bfd_boolean *again)
 {
   bfd_byte *contents = elf_section_data (sec)->this_hdr.contents;
-  bfd_signed_vma foff = symval - (sec_addr (sec) + rel->r_offset);
+  bfd_signed_vma foff = symval - (sec_addr (sec)
+				  + riscv_relax_map_offset (del, rel->r_offset));
   bfd_boolean near_zero = !link_info->shared && symval < RISCV_IMM_REACH/2;
+  bfd_boolean rvc = (elf_elfheader (abfd)->e_flags & EF_RISCV_RVC) != 0;
   bfd_vma auipc, jalr;
-  int r_type;
+  int rd, r_type;
 
   /* See if this function call can be shortened.  */
   if (!VALID_UJTYPE_IMM (foff) && !near_zero)
@@ -2677,8 +3517,16 @@ _bfd_riscv_relax_call (bfd *abfd, asection *sec,
 
   auipc = bfd_get_32 (abfd, contents + rel->r_offset);
   jalr = bfd_get_32 (abfd, contents + rel->r_offset + 4);
+  rd = (jalr >> OP_SH_RD) & OP_MASK_RD;
+  rvc = rvc && VALID_RVC_J_IMM (foff) && (rd == 0 || (rd == X_RA && ARCH_SIZE == 32));
 
-  if (VALID_UJTYPE_IMM (foff))
+  if (rvc)
+    {
+      /* Relax to C.J or C.JAL addr.  */
+      r_type = R_RISCV_RVC_JUMP;
+      auipc = rd == 0 ? MATCH_C_J : MATCH_C_JAL;
+    }
+  else if (VALID_UJTYPE_IMM (foff))
     {
       /* Relax to JAL rd, addr.  */
       r_type = R_RISCV_JAL;
@@ -2694,11 +3542,15 @@ _bfd_riscv_relax_call (bfd *abfd, asection *sec,
   /* Replace the R_RISCV_CALL reloc.  */
   rel->r_info = ELFNN_R_INFO (ELFNN_R_SYM (rel->r_info), r_type);
   /* Replace the AUIPC.  */
-  bfd_put_32 (abfd, auipc, contents + rel->r_offset);
+  if (rvc)
+    bfd_put_16 (abfd, auipc, contents + rel->r_offset);
+  else
+    bfd_put_32 (abfd, auipc, contents + rel->r_offset);
 
-  /* Delete unnecessary JALR.  */
+  /* Delete unnecessary JALR, and the rest of the AUIPC if compressed.  */
   *again = TRUE;
-  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset + 4, 4);
+  return riscv_relax_delete_bytes (del, rel->r_offset + (rvc ? 2 : 4),
+				   rvc ? 6 : 4);
 }
 
 /* Relax non-PIC global variable references.  */
@@ -2708,30 +3560,57 @@ _bfd_riscv_relax_lui (bfd *abfd, asection *sec,
 		      struct bfd_link_info *link_info,
 		      Elf_Internal_Rela *rel,
 		      bfd_vma symval,
+		      riscv_pcrel_relocs *pcrel_relocs ATTRIBUTE_UNUSED,
+		      riscv_relax_deletions *del,
 		      bfd_boolean *again)
 {
+  bfd_byte *contents = elf_section_data (sec)->this_hdr.contents;
   bfd_vma gp = riscv_global_pointer_value (link_info);
+  bfd_vma lui;
+  int rd;
+
+  BFD_ASSERT (rel->r_offset + 4 <= sec->size);
 
-  /* Bail out if this symbol isn't in range of either gp or x0.  */
-  if (!VALID_ITYPE_IMM (symval - gp) && !(symval < RISCV_IMM_REACH/2))
+  if (!link_info->shared
+      && (VALID_ITYPE_IMM (symval - gp) || symval < RISCV_IMM_REACH/2))
+    {
+      /* We can delete the unnecessary LUI.  The corresponding LO12 reloc
+	 will be converted to GPREL during relocation, which is not done
+	 for shared objects or PIEs.  */
+      rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+
+      *again = TRUE;
+      return riscv_relax_delete_bytes (del, rel->r_offset, 4);
+    }
+
+  /* Otherwise, try to shorten the LUI to a C.LUI, which can't target
+     x0 or sp.  */
+  if (!(elf_elfheader (abfd)->e_flags & EF_RISCV_RVC)
+      || !VALID_RVC_LUI_IMM (RISCV_CONST_HIGH_PART (symval)))
     return TRUE;
 
-  /* We can delete the unnecessary AUIPC. The corresponding LO12 reloc
-     will be converted to GPREL during relocation.  */
-  BFD_ASSERT (rel->r_offset + 4 <= sec->size);
-  rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+  lui = bfd_get_32 (abfd, contents + rel->r_offset);
+  rd = (lui >> OP_SH_RD) & OP_MASK_RD;
+  if (rd == 0 || rd == X_SP)
+    return TRUE;
+
+  lui = (lui & (OP_MASK_RD << OP_SH_RD)) | MATCH_C_LUI;
+  bfd_put_16 (abfd, lui, contents + rel->r_offset);
+  rel->r_info = ELFNN_R_INFO (ELFNN_R_SYM (rel->r_info), R_RISCV_RVC_LUI);
 
   *again = TRUE;
-  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset, 4);
+  return riscv_relax_delete_bytes (del, rel->r_offset + 2, 2);
 }
 
 /* Relax non-PIC TLS references.  */
 
 static bfd_boolean
-_bfd_riscv_relax_tls_le (bfd *abfd, asection *sec,
+_bfd_riscv_relax_tls_le (bfd *abfd ATTRIBUTE_UNUSED, asection *sec,
 			 struct bfd_link_info *link_info,
 			 Elf_Internal_Rela *rel,
 			 bfd_vma symval,
+			 riscv_pcrel_relocs *pcrel_relocs ATTRIBUTE_UNUSED,
+			 riscv_relax_deletions *del,
 			 bfd_boolean *again)
 {
   /* See if this symbol is in range of tp.  */
@@ -2744,7 +3623,197 @@ _bfd_riscv_relax_tls_le (bfd *abfd, asection *sec,
   rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
 
   *again = TRUE;
-  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset, 4);
+  return riscv_relax_delete_bytes (del, rel->r_offset, 4);
+}
+
+/* Record every PC-relative high-part reloc in SEC, keyed by its offset,
+   along with the low-part relocs that consume it.  A low-part reloc
+   names a label on its high part, which must be in the same section.  */
+
+static bfd_boolean
+riscv_collect_pcrel_relocs (bfd *abfd, asection *sec,
+			    riscv_pcrel_relocs *p)
+{
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
+  Elf_Internal_Rela *relocs = elf_section_data (sec)->relocs;
+  unsigned int i;
+
+  if (!riscv_init_pcrel_relocs (p))
+    return FALSE;
+
+  for (i = 0; i < sec->reloc_count; i++)
+    {
+      Elf_Internal_Rela *rel = relocs + i;
+      riscv_pcrel_hi_reloc entry = {rel->r_offset, 0, rel, NULL, 0};
+      riscv_pcrel_hi_reloc **slot;
+
+      switch (ELFNN_R_TYPE (rel->r_info))
+	{
+	case R_RISCV_PCREL_HI20:
+	case R_RISCV_GOT_HI20:
+	case R_RISCV_TLS_GOT_HI20:
+	case R_RISCV_TLS_GD_HI20:
+	  break;
+	default:
+	  continue;
+	}
+
+      slot = (riscv_pcrel_hi_reloc **) htab_find_slot (p->hi_relocs, &entry,
+						       INSERT);
+      if (slot == NULL)
+	return FALSE;
+      if (*slot != NULL)
+	continue;
+      *slot = (riscv_pcrel_hi_reloc *) bfd_malloc (sizeof entry);
+      if (*slot == NULL)
+	return FALSE;
+      **slot = entry;
+    }
+
+  for (i = 0; i < sec->reloc_count; i++)
+    {
+      Elf_Internal_Rela *rel = relocs + i;
+      unsigned long r_symndx = ELFNN_R_SYM (rel->r_info);
+      riscv_pcrel_hi_reloc search = {0, 0, NULL, NULL, 0}, *entry;
+      Elf_Internal_Rela **lo_relocs;
+
+      if (ELFNN_R_TYPE (rel->r_info) != R_RISCV_PCREL_LO12_I
+	  && ELFNN_R_TYPE (rel->r_info) != R_RISCV_PCREL_LO12_S)
+	continue;
+
+      /* Find the label, and hence the high part, this reloc names.  */
+      if (r_symndx < symtab_hdr->sh_info)
+	{
+	  Elf_Internal_Sym *isym = ((Elf_Internal_Sym *) symtab_hdr->contents
+				    + r_symndx);
+	  if (isym->st_shndx >= elf_numsections (abfd)
+	      || elf_elfsections (abfd)[isym->st_shndx]->bfd_section != sec)
+	    continue;
+	  search.address = isym->st_value;
+	}
+      else
+	{
+	  struct elf_link_hash_entry *h;
+
+	  h = elf_sym_hashes (abfd)[r_symndx - symtab_hdr->sh_info];
+	  while (h->root.type == bfd_link_hash_indirect
+		 || h->root.type == bfd_link_hash_warning)
+	    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+	  if ((h->root.type != bfd_link_hash_defined
+	       && h->root.type != bfd_link_hash_defweak)
+	      || h->root.u.def.section != sec)
+	    continue;
+	  search.address = h->root.u.def.value;
+	}
+
+      entry = htab_find (p->hi_relocs, &search);
+      if (entry == NULL)
+	continue;
+
+      lo_relocs = bfd_realloc (entry->lo_relocs,
+			       (entry->lo_count + 1) * sizeof *lo_relocs);
+      if (lo_relocs == NULL)
+	return FALSE;
+      lo_relocs[entry->lo_count++] = rel;
+      entry->lo_relocs = lo_relocs;
+    }
+
+  return TRUE;
+}
+
+/* Relax PC-relative and GOT-indirect address references.  A GOT load
+   of a symbol that binds locally becomes AUIPC + ADDI, in PIC links as
+   well.  Then, in a position-dependent executable, if the address is
+   within reach of gp, the AUIPC goes away and the low parts become
+   gp-relative.  */
+
+static bfd_boolean
+_bfd_riscv_relax_pc (bfd *abfd, asection *sec,
+		     struct bfd_link_info *link_info,
+		     Elf_Internal_Rela *rel,
+		     bfd_vma symval,
+		     riscv_pcrel_relocs *pcrel_relocs,
+		     riscv_relax_deletions *del,
+		     bfd_boolean *again)
+{
+  bfd_byte *contents = elf_section_data (sec)->this_hdr.contents;
+  bfd_vma gp = riscv_global_pointer_value (link_info);
+  bfd_boolean got = ELFNN_R_TYPE (rel->r_info) == R_RISCV_GOT_HI20;
+  riscv_pcrel_hi_reloc search = {rel->r_offset, 0, NULL, NULL, 0}, *entry;
+  bfd_boolean use_gp;
+  bfd_vma auipc;
+  unsigned int i;
+  int rd;
+
+  entry = htab_find (pcrel_relocs->hi_relocs, &search);
+  if (entry == NULL || entry->hi_reloc != rel || entry->lo_count == 0)
+    return TRUE;
+
+  /* gp belongs to the executable, so shared objects can't use it.
+     PIEs are linked with shared set too; leave them position
+     independent, since the low part might end up x0-relative.  */
+  use_gp = !link_info->shared && VALID_ITYPE_IMM (symval - gp);
+  if (!got && !use_gp)
+    return TRUE;
+
+  BFD_ASSERT (rel->r_offset + 4 <= sec->size);
+  auipc = bfd_get_32 (abfd, contents + rel->r_offset);
+  rd = (auipc >> OP_SH_RD) & OP_MASK_RD;
+
+  /* A GOT load can only be rewritten if every consumer is a plain load
+     of the GOT entry through the AUIPC's result.  */
+  if (got)
+    for (i = 0; i < entry->lo_count; i++)
+      {
+	Elf_Internal_Rela *lo = entry->lo_relocs[i];
+	bfd_vma insn = bfd_get_32 (abfd, contents + lo->r_offset);
+
+	if (ELFNN_R_TYPE (lo->r_info) != R_RISCV_PCREL_LO12_I
+	    || lo->r_addend != 0
+	    || (insn & MASK_LD) != (ARCH_SIZE == 64 ? MATCH_LD : MATCH_LW)
+	    || ((insn >> OP_SH_RS1) & OP_MASK_RS1) != (bfd_vma) rd)
+	  return TRUE;
+      }
+
+  for (i = 0; i < entry->lo_count; i++)
+    {
+      Elf_Internal_Rela *lo = entry->lo_relocs[i];
+
+      if (got)
+	{
+	  /* Replace the load with ADDI rd, rs1, 0; the offset is filled in
+	     when the low part is resolved.  */
+	  bfd_vma insn = bfd_get_32 (abfd, contents + lo->r_offset);
+	  insn &= (OP_MASK_RD << OP_SH_RD) | (OP_MASK_RS1 << OP_SH_RS1);
+	  bfd_put_32 (abfd, insn | MATCH_ADDI, contents + lo->r_offset);
+	}
+
+      if (use_gp)
+	{
+	  /* Make the low part refer to the symbol directly.  It will be
+	     converted to gp-relative during relocation.  */
+	  int r_type = (ELFNN_R_TYPE (lo->r_info) == R_RISCV_PCREL_LO12_S
+			? R_RISCV_LO12_S : R_RISCV_LO12_I);
+	  lo->r_info = ELFNN_R_INFO (ELFNN_R_SYM (rel->r_info), r_type);
+	  lo->r_addend += rel->r_addend;
+	}
+    }
+
+  if (!use_gp)
+    {
+      /* The AUIPC now computes the symbol's address, not its GOT entry's.
+	 The GOT entry itself was sized before relaxation and is kept.  */
+      rel->r_info = ELFNN_R_INFO (ELFNN_R_SYM (rel->r_info),
+				  R_RISCV_PCREL_HI20);
+      return TRUE;
+    }
+
+  /* We can delete the unnecessary AUIPC.  */
+  rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+  entry->lo_count = 0;
+
+  *again = TRUE;
+  return riscv_relax_delete_bytes (del, rel->r_offset, 4);
 }
 
 /* Implement R_RISCV_ALIGN by deleting excess alignment NOPs.  */
@@ -2754,9 +3823,13 @@ _bfd_riscv_relax_align (bfd *abfd, asection *sec,
 			struct bfd_link_info *link_info ATTRIBUTE_UNUSED,
 			Elf_Internal_Rela *rel,
 			bfd_vma symval,
+			riscv_pcrel_relocs *pcrel_relocs ATTRIBUTE_UNUSED,
+			riscv_relax_deletions *del,
 			bfd_boolean *again ATTRIBUTE_UNUSED)
 {
+  bfd_byte *contents = elf_section_data (sec)->this_hdr.contents;
   bfd_vma alignment = 1;
+  bfd_vma pos;
   while (alignment <= rel->r_addend)
     alignment *= 2;
 
@@ -2775,8 +3848,15 @@ _bfd_riscv_relax_align (bfd *abfd, asection *sec,
   if (nop_bytes_needed == rel->r_addend)
     return TRUE;
 
+  /* Rewrite the NOPs we keep, since with RVC the padding may end on a
+     2-byte boundary: full-size NOPs, then a C.NOP if needed.  */
+  for (pos = 0; pos + 4 <= nop_bytes_needed; pos += 4)
+    bfd_put_32 (abfd, RISCV_NOP, contents + rel->r_offset + pos);
+  if (pos < nop_bytes_needed)
+    bfd_put_16 (abfd, RVC_NOP, contents + rel->r_offset + pos);
+
   /* Delete the excess NOPs.  */
-  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset,
+  return riscv_relax_delete_bytes (del, rel->r_offset + nop_bytes_needed,
 				   rel->r_addend - nop_bytes_needed);
 }
 
@@ -2791,6 +3871,8 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
   struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
   struct bfd_elf_section_data *data = elf_section_data (sec);
   Elf_Internal_Rela *relocs;
+  riscv_relax_deletions del = {NULL, 0, 0};
+  riscv_pcrel_relocs pcrel_relocs = {NULL, NULL};
   bfd_boolean ret = FALSE;
   unsigned int i;
 
@@ -2820,12 +3902,24 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
 
       if (info->relax_pass == 0)
 	{
+	  /* Leave the __tls_get_addr call of a GD sequence alone in an
+	     executable; relocate_section rewrites it in place.  */
+	  if ((type == R_RISCV_CALL || type == R_RISCV_CALL_PLT)
+	      && info->executable
+	      && i >= 2
+	      && ELFNN_R_TYPE (rel[-2].r_info) == R_RISCV_TLS_GD_HI20
+	      && riscv_elf_tls_sequence_p (abfd, rel - 2,
+					   relocs + sec->reloc_count))
+	    continue;
+
 	  if (type == R_RISCV_CALL || type == R_RISCV_CALL_PLT)
 	    relax_func = _bfd_riscv_relax_call;
 	  else if (type == R_RISCV_HI20)
 	    relax_func = _bfd_riscv_relax_lui;
 	  else if (type == R_RISCV_TPREL_HI20 || type == R_RISCV_TPREL_ADD)
 	    relax_func = _bfd_riscv_relax_tls_le;
+	  else if (type == R_RISCV_PCREL_HI20 || type == R_RISCV_GOT_HI20)
+	    relax_func = _bfd_riscv_relax_pc;
 	}
       else if (type == R_RISCV_ALIGN)
 	relax_func = _bfd_riscv_relax_align;
@@ -2849,6 +3943,12 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
 						       0, NULL, NULL, NULL)))
 	goto fail;
 
+      /* Pair up the PC-relative relocs before rewriting any of them.  */
+      if (relax_func == _bfd_riscv_relax_pc
+	  && pcrel_relocs.hi_relocs == NULL
+	  && !riscv_collect_pcrel_relocs (abfd, sec, &pcrel_relocs))
+	goto fail;
+
       /* Get the value of the symbol referred to by the reloc.  */
       if (ELFNN_R_SYM (rel->r_info) < symtab_hdr->sh_info)
 	{
@@ -2856,16 +3956,32 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
 	  Elf_Internal_Sym *isym = ((Elf_Internal_Sym *) symtab_hdr->contents
 				    + ELFNN_R_SYM (rel->r_info));
 
-	  if (isym->st_shndx == SHN_UNDEF)
-	    symval = sec_addr (sec) + rel->r_offset;
+	  if (ELF_ST_TYPE (isym->st_info) == STT_GNU_IFUNC)
+	    {
+	      /* References to local STT_GNU_IFUNC symbols are bound to
+		 their PLT entries.  */
+	      struct elf_link_hash_entry *h
+		= riscv_elf_get_local_sym_hash (htab, abfd, rel, FALSE);
+	      if (h == NULL || h->plt.offset == MINUS_ONE
+		  || relax_func == _bfd_riscv_relax_pc)
+		continue;
+	      symval = sec_addr (riscv_elf_plt_section (htab)) + h->plt.offset;
+	    }
+	  else if (isym->st_shndx == SHN_UNDEF)
+	    symval = sec_addr (sec) + riscv_relax_map_offset (&del,
+							      rel->r_offset);
 	  else
 	    {
 	      asection *isec;
+	      bfd_vma value = isym->st_value;
 	      BFD_ASSERT (isym->st_shndx < elf_numsections (abfd));
 	      isec = elf_elfsections (abfd)[isym->st_shndx]->bfd_section;
 	      if (sec_addr (isec) == 0)
 		continue;
-	      symval = sec_addr (isec) + isym->st_value;
+	      /* Account for bytes already scheduled for deletion.  */
+	      if (isec == sec)
+		value = riscv_relax_map_offset (&del, value);
+	      symval = sec_addr (isec) + value;
 	    }
 	}
       else
@@ -2880,29 +3996,48 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
 		 || h->root.type == bfd_link_hash_warning)
 	    h = (struct elf_link_hash_entry *) h->root.u.i.link;
 
+	  /* Only a symbol that binds locally, and whose address is not
+	     that of a PLT entry, can be addressed directly.  */
+	  if (relax_func == _bfd_riscv_relax_pc
+	      && (h->type == STT_GNU_IFUNC
+		  || h->plt.offset != MINUS_ONE
+		  || (type == R_RISCV_GOT_HI20
+		      && !SYMBOL_REFERENCES_LOCAL (info, h))))
+	    continue;
+
 	  if (h->plt.offset != MINUS_ONE)
-	    symval = sec_addr (htab->elf.splt) + h->plt.offset;
+	    symval = sec_addr (riscv_elf_plt_section (htab)) + h->plt.offset;
 	  else if (h->root.type == bfd_link_hash_undefweak)
 	    symval = 0;
 	  else if (h->root.u.def.section->output_section == NULL
 		   || (h->root.type != bfd_link_hash_defined
 		       && h->root.type != bfd_link_hash_defweak))
 	    continue;
+	  else if (h->root.u.def.section == sec)
+	    symval = sec_addr (sec) + riscv_relax_map_offset (&del,
+							      h->root.u.def.value);
 	  else
 	    symval = sec_addr (h->root.u.def.section) + h->root.u.def.value;
 	}
 
       symval += rel->r_addend;
 
-      if (!relax_func (abfd, sec, info, rel, symval, again))
+      if (!relax_func (abfd, sec, info, rel, symval, &pcrel_relocs, &del,
+		       again))
 	goto fail;
     }
 
+  /* Compact the section once, now that every reloc has been examined.  */
+  riscv_relax_apply_deletions (abfd, sec, &del);
+
   ret = TRUE;
 
 fail:
   if (relocs != data->relocs)
     free (relocs);
+  free (del.entries);
+  if (pcrel_relocs.hi_relocs != NULL)
+    riscv_free_pcrel_relocs (&pcrel_relocs);
 
   return ret;
 }
@@ -32,6 +32,7 @@
 
 #include "elf/riscv.h"
 #include "opcode/riscv.h"
+#include "opcode/riscv-const.h"
 
 #include <execinfo.h>
 #include <stdint.h>
@@ -60,6 +61,36 @@ bfd_boolean rv64 = TRUE; /* RV64 (true) or RV32 (false) */
 #define LOAD_ADDRESS_INSN (rv64 ? "ld" : "lw")
 #define ADD32_INSN (rv64 ? "addiw" : "addi")
 
+/* This is the set of options which may be modified by the .set
+   pseudo-op.  We use a struct so that .set push and .set pop are more
+   reliable.  */
+
+struct riscv_set_options
+{
+  /* Generate position-independent code.  */
+  int pic;
+  /* Generate RVC code.  */
+  int rvc;
+};
+
+static struct riscv_set_options riscv_opts =
+{
+  0,	/* pic */
+  0,	/* rvc */
+};
+
+/* Set if RVC was enabled at any point, so the object is marked as
+   possibly containing compressed instructions.  */
+static bfd_boolean riscv_rvc_used = FALSE;
+
+static void
+riscv_set_rvc (bfd_boolean rvc_value)
+{
+  riscv_opts.rvc = rvc_value;
+  if (rvc_value)
+    riscv_rvc_used = TRUE;
+}
+
 struct riscv_subset
 {
   const char* name;
@@ -76,6 +107,7 @@ riscv_subset_supports(const char* feature)
 {
   struct riscv_subset* s;
   bfd_boolean rv64_insn;
+  size_t len;
 
   if ((rv64_insn = !strncmp(feature, "64", 2)) || !strncmp(feature, "32", 2))
     {
@@ -84,8 +116,22 @@ riscv_subset_supports(const char* feature)
       feature += 2;
     }
 
+  /* RVC can be toggled with .option, so it isn't tracked as a subset.  */
+  if (strcmp(feature, "C") == 0)
+    return riscv_opts.rvc;
+
+  /* A trailing C, as in "DC", marks the compressed form of another
+     subset's instruction, which needs both that subset and RVC.  */
+  len = strlen(feature);
+  if (len > 1 && feature[0] != 'X' && feature[len - 1] == 'C')
+    {
+      if (!riscv_opts.rvc)
+        return 0;
+      len--;
+    }
+
   for (s = riscv_subsets; s != NULL; s = s->next)
-    if (strcmp(s->name, feature) == 0)
+    if (strlen(s->name) == len && strncmp(s->name, feature, len) == 0)
       /* FIXME: once we support version numbers:
          return major == s->version_major && minor <= s->version_minor; */
       return 1;
@@ -93,6 +139,18 @@ riscv_subset_supports(const char* feature)
   return 0;
 }
 
+/* Return true if SUBSET names the compressed extension, alone or as
+   in "DC".  */
+
+static int
+riscv_subset_is_rvc(const char* subset)
+{
+  if (!strncmp(subset, "64", 2) || !strncmp(subset, "32", 2))
+    subset += 2;
+  return subset[0] != 'X' && subset[0] != 0
+	 && subset[strlen(subset) - 1] == 'C';
+}
+
 static void
 riscv_add_subset(const char* subset)
 {
@@ -113,7 +171,7 @@ riscv_set_arch(const char* arg)
      is supported in this case).
      
      FIXME: Version numbers are not supported yet. */
-  const char* subsets = "IMAFD";
+  const char* subsets = "IMAFDC";
   const char* p;
   
   for (p = arg; *p; p++)
@@ -126,7 +184,10 @@ riscv_set_arch(const char* arg)
       for (p = arg; *p; p++)
         {
           char subset[2] = {TOUPPER(*p), 0};
-          riscv_add_subset(subset);
+          if (subset[0] == 'C')
+            riscv_set_rvc(TRUE);
+          else
+            riscv_add_subset(subset);
         }
       return;
     }
@@ -162,6 +223,8 @@ riscv_set_arch(const char* arg)
           riscv_add_subset(subset);
           p = q-1;
         }
+      else if (*p == 'C')
+        riscv_set_rvc(TRUE);
       else if (strchr(subsets, *p) != NULL)
         {
           char subset[2] = {*p, 0};
@@ -172,24 +235,6 @@ riscv_set_arch(const char* arg)
     }
 }
 
-/* This is the set of options which may be modified by the .set
-   pseudo-op.  We use a struct so that .set push and .set pop are more
-   reliable.  */
-
-struct riscv_set_options
-{
-  /* Generate position-independent code.  */
-  int pic;
-  /* Generate RVC code.  */
-  int rvc;
-};
-
-static struct riscv_set_options riscv_opts =
-{
-  0,	/* pic */
-  0,	/* rvc */
-};
-
 /* handle of the OPCODE hash table */
 static struct hash_control *op_hash = NULL;
 
@@ -224,14 +269,16 @@ const char FLT_CHARS[] = "rRsSfFdDxXpP";
 
 static char *insn_error;
 
-#define RELAX_BRANCH_ENCODE(uncond, toofar)		\
+#define RELAX_BRANCH_ENCODE(uncond, rvc, length)	\
   ((relax_substateT) 					\
    (0xc0000000						\
-    | ((toofar) ? 1 : 0)				\
-    | ((uncond) ? 2 : 0)))
+    | ((uncond) ? 1 : 0)				\
+    | ((rvc) ? 2 : 0)					\
+    | ((length) << 2)))
 #define RELAX_BRANCH_P(i) (((i) & 0xf0000000) == 0xc0000000)
-#define RELAX_BRANCH_TOOFAR(i) (((i) & 1) != 0)
-#define RELAX_BRANCH_UNCOND(i) (((i) & 2) != 0)
+#define RELAX_BRANCH_LENGTH(i) (((i) >> 2) & 0xF)
+#define RELAX_BRANCH_RVC(i) (((i) & 2) != 0)
+#define RELAX_BRANCH_UNCOND(i) (((i) & 1) != 0)
 
 /* Is the given value a sign-extended 32-bit value?  */
 #define IS_SEXT_32BIT_NUM(x)						\
@@ -366,36 +413,41 @@ add_relaxed_insn (struct riscv_cl_insn *insn, int max_chars, int var,
 }
 
 /* Compute the length of a branch sequence, and adjust the
-   RELAX_BRANCH_TOOFAR bit accordingly.  If FRAGP is NULL, the
-   worst-case length is computed. */
+   RELAX_BRANCH_LENGTH field accordingly.  If FRAGP is NULL, the
+   worst-case length is computed.  Branches that are out of range
+   become an inverted branch over a JAL; jumps are assumed to be in
+   range, and the linker will catch any that aren't.  */
 static int
 relaxed_branch_length (fragS *fragp, asection *sec, int update)
 {
-  bfd_boolean toofar = TRUE;
+  bfd_boolean uncond, rvc;
+  int length;
 
-  if (fragp)
-    {
-      bfd_boolean uncond = RELAX_BRANCH_UNCOND (fragp->fr_subtype);
-
-      if (S_IS_DEFINED (fragp->fr_symbol)
-	  && sec == S_GET_SEGMENT (fragp->fr_symbol))
-	{
-	  offsetT val = S_GET_VALUE (fragp->fr_symbol) + fragp->fr_offset;
-	  bfd_vma range;
-	  val -= fragp->fr_address + fragp->fr_fix;
+  if (fragp == NULL)
+    return 8;
 
-	  if (uncond)
-	    range = RISCV_JUMP_REACH;
-	  else
-	    range = RISCV_BRANCH_REACH;
-	  toofar = (bfd_vma)(val + range/2) >= range;
-	}
+  uncond = RELAX_BRANCH_UNCOND (fragp->fr_subtype);
+  rvc = RELAX_BRANCH_RVC (fragp->fr_subtype);
+  length = uncond ? 4 : rvc ? 6 : 8;
 
-      if (update && toofar != RELAX_BRANCH_TOOFAR (fragp->fr_subtype))
-	fragp->fr_subtype = RELAX_BRANCH_ENCODE (uncond, toofar);
+  if (S_IS_DEFINED (fragp->fr_symbol)
+      && sec == S_GET_SEGMENT (fragp->fr_symbol))
+    {
+      offsetT val = S_GET_VALUE (fragp->fr_symbol) + fragp->fr_offset;
+      bfd_vma range = uncond ? RISCV_JUMP_REACH : RISCV_BRANCH_REACH;
+      bfd_vma rvc_range = uncond ? RVC_JUMP_REACH : RVC_BRANCH_REACH;
+      val -= fragp->fr_address + fragp->fr_fix;
+
+      if (rvc && (bfd_vma)(val + rvc_range/2) < rvc_range)
+	length = 2;
+      else if ((bfd_vma)(val + range/2) < range)
+	length = 4;
     }
 
-  return toofar ? 8 : 4;
+  if (update)
+    fragp->fr_subtype = RELAX_BRANCH_ENCODE (uncond, rvc, length);
+
+  return length;
 }
 
 struct regname {
@@ -546,6 +598,38 @@ validate_riscv_insn (const struct riscv_opcode *opc)
           return 0;
         }
       break;
+      /* RVC */
+      case 'C':
+      switch (c = *p++)
+        {
+        case 'a': used_bits |= ENCODE_RVC_J_IMM(-1U); break;
+        case 'c': break; /* RS1, constrained to equal sp */
+        case 'D': USE_BITS (OP_MASK_CRS2S, OP_SH_CRS2S); break;
+        case 'j': used_bits |= ENCODE_RVC_IMM(-1U); break;
+        case 'k': used_bits |= ENCODE_RVC_LW_IMM(-1U); break;
+        case 'K': used_bits |= ENCODE_RVC_ADDI4SPN_IMM(-1U); break;
+        case 'l': used_bits |= ENCODE_RVC_LD_IMM(-1U); break;
+        case 'L': used_bits |= ENCODE_RVC_ADDI16SP_IMM(-1U); break;
+        case 'm': used_bits |= ENCODE_RVC_LWSP_IMM(-1U); break;
+        case 'M': used_bits |= ENCODE_RVC_SWSP_IMM(-1U); break;
+        case 'n': used_bits |= ENCODE_RVC_LDSP_IMM(-1U); break;
+        case 'N': used_bits |= ENCODE_RVC_SDSP_IMM(-1U); break;
+        case 'o': used_bits |= ENCODE_RVC_IMM(-1U); break;
+        case 'p': used_bits |= ENCODE_RVC_B_IMM(-1U); break;
+        case 's': USE_BITS (OP_MASK_CRS1S, OP_SH_CRS1S); break;
+        case 't': USE_BITS (OP_MASK_CRS2S, OP_SH_CRS2S); break;
+        case 'T': USE_BITS (OP_MASK_CRS2, OP_SH_CRS2); break;
+        case 'u': used_bits |= ENCODE_RVC_IMM(-1U); break;
+        case 'U': break; /* RS1, constrained to equal RD */
+        case 'V': USE_BITS (OP_MASK_CRS2, OP_SH_CRS2); break;
+        case 'w': break; /* RS1S, constrained to equal RD */
+        case '>': used_bits |= ENCODE_RVC_IMM(-1U); break;
+        default:
+          as_bad (_("internal: bad RISC-V opcode (unknown operand type `C%c'): %s %s"),
+                  c, opc->name, opc->args);
+          return 0;
+        }
+      break;
       case ',': break;
       case '(': break;
       case ')': break;
@@ -590,6 +674,108 @@ validate_riscv_insn (const struct riscv_opcode *opc)
   return 1;
 }
 
+/* The most comma-separated operands that riscv_ip checks up front.  */
+#define RISCV_MAX_OPERANDS 6
+
+/* What a comma-separated operand of an instruction must look like.
+   Anything other than a lone register is left to riscv_ip.  */
+
+enum riscv_operand_kind
+{
+  OPERAND_ANY,
+  OPERAND_GPR,
+  OPERAND_GPR_RVC,	/* x8-x15.  */
+  OPERAND_GPR_SP,
+  OPERAND_GPR_FIRST,	/* The same GPR as the first operand.  */
+  OPERAND_FPR,
+  OPERAND_FPR_RVC	/* f8-f15.  */
+};
+
+/* The operands of a riscv_opcodes entry, compiled from its argument
+   string by md_begin.  NUM is -1 if the entry has too many operands
+   to describe, in which case riscv_ip always tries it.  */
+
+struct riscv_operand_shape
+{
+  int num;
+  unsigned char kind[RISCV_MAX_OPERANDS];
+};
+
+static struct riscv_operand_shape *riscv_opcode_shapes;
+
+/* One comma-separated operand of the instruction being assembled.
+   RCLASS is -1 if it is not a register.  */
+
+struct riscv_operand_token
+{
+  int rclass;
+  unsigned int regno;
+};
+
+/* Return the kind of operand described by the LEN characters of
+   argument string at P.  */
+
+static enum riscv_operand_kind
+riscv_operand_kind (const char *p, size_t len)
+{
+  if (len == 1)
+    switch (*p)
+      {
+      case 'd': case 's': case 't':
+	return OPERAND_GPR;
+      case 'D': case 'S': case 'T': case 'U': case 'R':
+	return OPERAND_FPR;
+      }
+  else if (len == 2 && *p == 'C')
+    switch (p[1])
+      {
+      case 's': case 't':
+	return OPERAND_GPR_RVC;
+      case 'w': case 'U':
+	return OPERAND_GPR_FIRST;
+      case 'c':
+	return OPERAND_GPR_SP;
+      case 'V':
+	return OPERAND_GPR;
+      case 'D':
+	return OPERAND_FPR_RVC;
+      case 'T':
+	return OPERAND_FPR;
+      }
+
+  return OPERAND_ANY;
+}
+
+/* Compile the argument string of OPC into SHAPE.  */
+
+static void
+riscv_compile_operand_shape (const struct riscv_opcode *opc,
+			     struct riscv_operand_shape *shape)
+{
+  const char *p = opc->args, *start;
+
+  shape->num = 0;
+  if (*p == '\0')
+    return;
+
+  for (;;)
+    {
+      for (start = p; *p != '\0' && *p != ','; p++)
+	if ((*p == 'C' || *p == '#' || *p == '^') && p[1] != '\0')
+	  p++;
+
+      if (shape->num == RISCV_MAX_OPERANDS)
+	{
+	  shape->num = -1;
+	  return;
+	}
+      shape->kind[shape->num++] = riscv_operand_kind (start, p - start);
+
+      if (*p++ == '\0')
+	return;
+    }
+}
+
 struct percent_op_match
 {
   const char *str;
@@ -613,9 +799,18 @@ md_begin (void)
   for (i = 0; i < NUMOPCODES;)
     {
       const char *name = riscv_opcodes[i].name;
-
-      if (riscv_subset_supports(riscv_opcodes[i].subset))
-        retval = hash_insert (op_hash, name, (void *) &riscv_opcodes[i]);
+      int j;
+
+      /* Hash the group if any of its entries may be used.  Whether
+	 compressed entries apply can change with .option rvc, so they
+	 are always kept; riscv_ip skips unsupported entries.  */
+      for (j = i; j < NUMOPCODES && !strcmp (riscv_opcodes[j].name, name); j++)
+	if (riscv_subset_supports (riscv_opcodes[j].subset)
+	    || riscv_subset_is_rvc (riscv_opcodes[j].subset))
+	  {
+	    retval = hash_insert (op_hash, name, (void *) &riscv_opcodes[i]);
+	    break;
+	  }
 
       if (retval != NULL)
 	{
@@ -648,6 +843,11 @@ md_begin (void)
 #include "opcode/riscv-opc.h"
 #undef DECLARE_CSR
 
+  riscv_opcode_shapes = (struct riscv_operand_shape *)
+    xmalloc (NUMOPCODES * sizeof (struct riscv_operand_shape));
+  for (i = 0; i < NUMOPCODES; i++)
+    riscv_compile_operand_shape (&riscv_opcodes[i], &riscv_opcode_shapes[i]);
+
   /* set the default alignment for the text section (2**2) */
   record_alignment (text_section, 2);
 }
@@ -695,10 +895,14 @@ append_insn (struct riscv_cl_insn *ip, expressionS *address_expr,
 	    }
 	    reloc_type = BFD_RELOC_UNUSED;
 	}
-      else if (reloc_type == BFD_RELOC_12_PCREL)
+      else if (reloc_type == BFD_RELOC_12_PCREL
+	       || (reloc_type == BFD_RELOC_RISCV_JMP && insn_length (ip) == 2))
 	{
-	  add_relaxed_insn (ip, relaxed_branch_length (NULL, NULL, 0), 4,
-			    RELAX_BRANCH_ENCODE (0, 0),
+	  /* Branches, and compressed jumps, may need to be expanded.  */
+	  int j = reloc_type == BFD_RELOC_RISCV_JMP;
+	  int len = insn_length (ip);
+	  add_relaxed_insn (ip, relaxed_branch_length (NULL, NULL, 0), len,
+			    RELAX_BRANCH_ENCODE (j, len == 2, len),
 			    address_expr->X_add_symbol,
 			    address_expr->X_add_number);
 	  return;
@@ -756,6 +960,11 @@ macro_build (expressionS *ep, const char *name, const char *fmt, ...)
   r = BFD_RELOC_UNUSED;
   mo = (struct riscv_opcode *) hash_find (op_hash, name);
   gas_assert (mo);
+
+  /* Macros expand to full-size instructions; skip any compressed
+     variants listed first.  */
+  while (mo->pinfo != INSN_MACRO && riscv_insn_length (mo->match) < 4)
+    mo++;
   gas_assert (strcmp (name, mo->name) == 0);
 
   create_insn (&insn, mo);
@@ -882,40 +1091,48 @@ check_absolute_expr (struct riscv_cl_insn *ip, expressionS *ex)
 static void
 load_const (int reg, expressionS *ep)
 {
-  int shift = RISCV_IMM_BITS;
-  expressionS upper = *ep, lower = *ep;
-  lower.X_add_number = (int32_t) ep->X_add_number << (32-shift) >> (32-shift);
-  upper.X_add_number -= lower.X_add_number;
+  struct riscv_const_op ops[RISCV_CONST_MAX_OPS];
+  expressionS imm;
+  int i, n;
 
   gas_assert (ep->X_op == O_constant);
 
-  if (rv64 && !IS_SEXT_32BIT_NUM(ep->X_add_number))
+  n = riscv_build_const (ops, ep->X_add_number, rv64 ? 64 : 32);
+  gas_assert (n > 0);
+
+  imm = *ep;
+  for (i = 0; i < n; i++)
     {
-      /* Reduce to a signed 32-bit constant using SLLI and ADDI, which
-	 is not optimal but also not so bad.  */
-      while (((upper.X_add_number >> shift) & 1) == 0)
-	shift++;
+      imm.X_add_number = ops[i].value;
+      switch (ops[i].code)
+	{
+	case RISCV_CONST_LUI:
+	  macro_build (&imm, "lui", "d,u", reg, BFD_RELOC_RISCV_HI20);
+	  break;
 
-      upper.X_add_number = (int64_t) upper.X_add_number >> shift;
-      load_const(reg, &upper);
+	case RISCV_CONST_ADDI:
+	  macro_build (&imm, "addi", "d,s,j", reg, i == 0 ? 0 : reg,
+		       BFD_RELOC_RISCV_LO12_I);
+	  break;
 
-      macro_build (NULL, "slli", "d,s,>", reg, reg, shift);
-      if (lower.X_add_number != 0)
-	macro_build (&lower, "addi", "d,s,j", reg, reg, BFD_RELOC_RISCV_LO12_I);
-    }
-  else
-    {
-      int hi_reg = 0;
+	case RISCV_CONST_ADDIW:
+	  macro_build (&imm, "addiw", "d,s,j", reg, reg,
+		       BFD_RELOC_RISCV_LO12_I);
+	  break;
 
-      if (upper.X_add_number != 0)
-	{
-	  macro_build (ep, "lui", "d,u", reg, BFD_RELOC_RISCV_HI20);
-	  hi_reg = reg;
-	}
+	case RISCV_CONST_XORI:
+	  macro_build (&imm, "xori", "d,s,j", reg, reg,
+		       BFD_RELOC_RISCV_LO12_I);
+	  break;
 
-      if (lower.X_add_number != 0 || hi_reg == 0)
-        macro_build (ep, ADD32_INSN, "d,s,j", reg, hi_reg,
-		     BFD_RELOC_RISCV_LO12_I);
+	case RISCV_CONST_SLLI:
+	  macro_build (NULL, "slli", "d,s,>", reg, reg, (int) ops[i].value);
+	  break;
+
+	case RISCV_CONST_SRLI:
+	  macro_build (NULL, "srli", "d,s,>", reg, reg, (int) ops[i].value);
+	  break;
+	}
     }
 }
 
@@ -1178,6 +1395,135 @@ my_getSmallExpression (expressionS *ep, bfd_reloc_code_real_type *reloc,
   return reloc_index;
 }
 
+/* Parse a constant operand of a compressed instruction from *S into EP.
+   Return FALSE, leaving *S alone, if the operand isn't a plain constant,
+   so that the caller can fall back to a full-size instruction.  */
+
+static bfd_boolean
+riscv_get_rvc_constant (expressionS *ep, char **s)
+{
+  if (**s == '%')
+    return FALSE;
+
+  my_getExpression (ep, *s);
+  if (ep->X_op != O_constant)
+    return FALSE;
+
+  *s = expr_end;
+  return TRUE;
+}
+
+/* Likewise, for the offset of a compressed load or store.  A bare
+   "(reg)" means an offset of zero.  */
+
+static bfd_boolean
+riscv_get_rvc_offset (expressionS *ep, char **s)
+{
+  if (**s == '(' && strchr (*s + 1, '(') == 0)
+    {
+      ep->X_op = O_constant;
+      ep->X_add_number = 0;
+      return TRUE;
+    }
+
+  return riscv_get_rvc_constant (ep, s);
+}
+
+/* Split the operands at S at their commas into TOKENS, noting which
+   are registers, and return how many there are.  Return -1 if they
+   can't be split reliably, in which case every opcode must be tried.  */
+
+static int
+riscv_tokenize_operands (char *s, struct riscv_operand_token *tokens)
+{
+  char *start, *end, save_c;
+  struct regname *r;
+  int n = 0;
+
+  s += strspn (s, " \t");
+  if (*s == '\0')
+    return 0;
+
+  for (;;)
+    {
+      for (start = s; *s != '\0' && *s != ','; s++)
+	if (*s == '"' || *s == '\'')
+	  return -1;
+
+      if (n == RISCV_MAX_OPERANDS)
+	return -1;
+
+      /* Look the operand up as a register name.  */
+      start += strspn (start, " \t");
+      for (end = s; end > start && (end[-1] == ' ' || end[-1] == '\t'); end--)
+	continue;
+      save_c = *end;
+      *end = '\0';
+      r = (struct regname *) hash_find (reg_names_hash, start);
+      *end = save_c;
+
+      tokens[n].rclass = r == NULL ? -1 : (int) DECODE_REG_CLASS (r);
+      tokens[n].regno = r == NULL ? 0 : DECODE_REG_NUM (r);
+      n++;
+
+      if (*s++ == '\0')
+	return n;
+    }
+}
+
+/* Return false if the NTOKENS operands in TOKENS certainly can't be
+   assembled as an instruction with operand shape SHAPE.  */
+
+static bfd_boolean
+riscv_operands_may_match (const struct riscv_operand_shape *shape,
+			  const struct riscv_operand_token *tokens,
+			  int ntokens)
+{
+  int i;
+
+  if (shape->num < 0 || ntokens < 0)
+    return TRUE;
+  if (shape->num != ntokens)
+    return FALSE;
+
+  for (i = 0; i < ntokens; i++)
+    switch (shape->kind[i])
+      {
+      case OPERAND_ANY:
+	break;
+      case OPERAND_GPR:
+	if (tokens[i].rclass != RCLASS_GPR)
+	  return FALSE;
+	break;
+      case OPERAND_GPR_RVC:
+	if (tokens[i].rclass != RCLASS_GPR
+	    || tokens[i].regno < 8 || tokens[i].regno > 15)
+	  return FALSE;
+	break;
+      case OPERAND_GPR_SP:
+	if (tokens[i].rclass != RCLASS_GPR || tokens[i].regno != X_SP)
+	  return FALSE;
+	break;
+      case OPERAND_GPR_FIRST:
+	if (tokens[i].rclass != RCLASS_GPR
+	    || tokens[0].rclass != RCLASS_GPR
+	    || tokens[i].regno != tokens[0].regno)
+	  return FALSE;
+	break;
+      case OPERAND_FPR:
+	if (tokens[i].rclass != RCLASS_FPR)
+	  return FALSE;
+	break;
+      case OPERAND_FPR_RVC:
+	if (tokens[i].rclass != RCLASS_FPR
+	    || tokens[i].regno < 8 || tokens[i].regno > 15)
+	  return FALSE;
+	break;
+      }
+
+  return TRUE;
+}
+
 /* This routine assembles an instruction into its binary format.  As a
    side effect, it sets one of the global variables imm_reloc or
    offset_reloc to the type of relocation to do if one of the operands
@@ -1195,6 +1541,8 @@ riscv_ip (char *str, struct riscv_cl_insn *ip)
   char save_c = 0;
   int argnum;
   const struct percent_op_match *p;
+  struct riscv_operand_token tokens[RISCV_MAX_OPERANDS];
+  int ntokens;
 
   insn_error = NULL;
 
@@ -1247,23 +1595,183 @@ riscv_ip (char *str, struct riscv_cl_insn *ip)
     }
 
   argsStart = s;
+  ntokens = riscv_tokenize_operands (s, tokens);
   for (;;)
     {
       bfd_boolean ok = TRUE;
+      expressionS rvc_expr;
       gas_assert (strcmp (insn->name, str) == 0);
 
       create_insn (ip, insn);
       insn_error = NULL;
       argnum = 1;
+
+      /* Skip entries from subsets that aren't enabled, e.g. compressed
+	 forms after .option norvc.  */
+      if (!riscv_subset_supports (insn->subset))
+	goto next_insn;
+
+      /* Skip entries whose operands can't match without parsing them.  */
+      if (!riscv_operands_may_match (&riscv_opcode_shapes[insn - riscv_opcodes],
+				     tokens, ntokens))
+	goto next_insn;
+
       for (args = insn->args;; ++args)
 	{
 	  s += strspn (s, " \t");
 	  switch (*args)
 	    {
 	    case '\0':		/* end of args */
-	      if (*s == '\0')
+	      if (*s == '\0'
+		  && (insn->pinfo == INSN_MACRO
+		      || insn->match_func (insn, ip->insn_opcode)))
 		return;
 	      break;
+
+	    /* RVC */
+	    case 'C':
+	      switch (*++args)
+		{
+		case 's': /* RS1 x8-x15 */
+		  if (!reg_lookup (&s, RCLASS_GPR, &regno)
+		      || !(regno >= 8 && regno <= 15))
+		    break;
+		  INSERT_OPERAND (CRS1S, *ip, regno % 8);
+		  continue;
+		case 'w': /* RS1 x8-x15, constrained to equal RD x8-x15 */
+		  if (!reg_lookup (&s, RCLASS_GPR, &regno)
+		      || EXTRACT_OPERAND (CRS1S, *ip) + 8 != regno)
+		    break;
+		  continue;
+		case 't': /* RS2 x8-x15 */
+		  if (!reg_lookup (&s, RCLASS_GPR, &regno)
+		      || !(regno >= 8 && regno <= 15))
+		    break;
+		  INSERT_OPERAND (CRS2S, *ip, regno % 8);
+		  continue;
+		case 'U': /* RS1, constrained to equal RD */
+		  if (!reg_lookup (&s, RCLASS_GPR, &regno)
+		      || EXTRACT_OPERAND (RD, *ip) != regno)
+		    break;
+		  continue;
+		case 'c': /* RS1, constrained to equal sp */
+		  if (!reg_lookup (&s, RCLASS_GPR, &regno)
+		      || regno != X_SP)
+		    break;
+		  continue;
+		case 'V': /* RS2 */
+		  if (!reg_lookup (&s, RCLASS_GPR, &regno))
+		    break;
+		  INSERT_OPERAND (CRS2, *ip, regno);
+		  continue;
+		case 'D': /* floating-point RS2 x8-x15 */
+		  if (!reg_lookup (&s, RCLASS_FPR, &regno)
+		      || !(regno >= 8 && regno <= 15))
+		    break;
+		  INSERT_OPERAND (CRS2S, *ip, regno % 8);
+		  continue;
+		case 'T': /* floating-point RS2 */
+		  if (!reg_lookup (&s, RCLASS_FPR, &regno))
+		    break;
+		  INSERT_OPERAND (CRS2, *ip, regno);
+		  continue;
+		case '>': /* shift amount, 1 - (XLEN-1) */
+		  if (!riscv_get_rvc_constant (&rvc_expr, &s)
+		      || rvc_expr.X_add_number <= 0
+		      || rvc_expr.X_add_number > (rv64 ? 63 : 31))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'o': /* 6-bit signed immediate */
+		  if (!riscv_get_rvc_constant (&rvc_expr, &s)
+		      || !VALID_RVC_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'j': /* nonzero 6-bit signed immediate */
+		  if (!riscv_get_rvc_constant (&rvc_expr, &s)
+		      || rvc_expr.X_add_number == 0
+		      || !VALID_RVC_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'u': /* upper 20 bits, as a 6-bit signed value */
+		  if (!riscv_get_rvc_constant (&rvc_expr, &s)
+		      || rvc_expr.X_add_number < 0
+		      || rvc_expr.X_add_number >= (signed)RISCV_BIGIMM_REACH)
+		    break;
+		  if (rvc_expr.X_add_number >= (signed)RISCV_BIGIMM_REACH/2)
+		    rvc_expr.X_add_number -= RISCV_BIGIMM_REACH;
+		  rvc_expr.X_add_number *= RISCV_IMM_REACH;
+		  if (!VALID_RVC_LUI_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_LUI_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'k': /* c.lw offset */
+		  if (!riscv_get_rvc_offset (&rvc_expr, &s)
+		      || !VALID_RVC_LW_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_LW_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'l': /* c.ld offset */
+		  if (!riscv_get_rvc_offset (&rvc_expr, &s)
+		      || !VALID_RVC_LD_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_LD_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'm': /* c.lwsp offset */
+		  if (!riscv_get_rvc_offset (&rvc_expr, &s)
+		      || !VALID_RVC_LWSP_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_LWSP_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'n': /* c.ldsp offset */
+		  if (!riscv_get_rvc_offset (&rvc_expr, &s)
+		      || !VALID_RVC_LDSP_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_LDSP_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'M': /* c.swsp offset */
+		  if (!riscv_get_rvc_offset (&rvc_expr, &s)
+		      || !VALID_RVC_SWSP_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_SWSP_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'N': /* c.sdsp offset */
+		  if (!riscv_get_rvc_offset (&rvc_expr, &s)
+		      || !VALID_RVC_SDSP_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode |= ENCODE_RVC_SDSP_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'K': /* c.addi4spn immediate */
+		  if (!riscv_get_rvc_constant (&rvc_expr, &s)
+		      || !VALID_RVC_ADDI4SPN_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode
+		    |= ENCODE_RVC_ADDI4SPN_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'L': /* c.addi16sp immediate */
+		  if (!riscv_get_rvc_constant (&rvc_expr, &s)
+		      || !VALID_RVC_ADDI16SP_IMM (rvc_expr.X_add_number))
+		    break;
+		  ip->insn_opcode
+		    |= ENCODE_RVC_ADDI16SP_IMM (rvc_expr.X_add_number);
+		  continue;
+		case 'p': /* branch target; relaxed by append_insn */
+		  offset_reloc = BFD_RELOC_12_PCREL;
+		  my_getExpression (&offset_expr, s);
+		  s = expr_end;
+		  continue;
+		case 'a': /* jump target; relaxed by append_insn */
+		  offset_reloc = BFD_RELOC_RISCV_JMP;
+		  my_getExpression (&offset_expr, s);
+		  s = expr_end;
+		  continue;
+		default:
+		  as_bad (_("bad RVC field specifier 'C%c'\n"), *args);
+		  internalError ();
+		}
+	      break;
             /* Xcustom */
             case '^':
             {
@@ -1622,6 +2130,7 @@ alu_op:
 	    }
 	  break;
 	}
+    next_insn:
       /* Args don't match.  */
       if (insn + 1 < &riscv_opcodes[NUMOPCODES] &&
 	  !strcmp (insn->name, insn[1].name))
@@ -1716,11 +2225,11 @@ md_parse_option (int c, char *arg)
   switch (c)
     {
     case OPTION_MRVC:
-      riscv_opts.rvc = 1;
+      riscv_set_rvc (TRUE);
       break;
 
     case OPTION_MNO_RVC:
-      riscv_opts.rvc = 0;
+      riscv_set_rvc (FALSE);
       break;
 
     case OPTION_M32:
@@ -1867,6 +2376,24 @@ md_apply_fix (fixS *fixP, valueT *valP, segT seg ATTRIBUTE_UNUSED)
 	}
       break;
 
+    case BFD_RELOC_RISCV_RVC_BRANCH:
+      if (fixP->fx_addsy)
+	{
+	  /* Fill in a tentative value to improve objdump readability.  */
+	  bfd_vma delta = ENCODE_RVC_B_IMM (S_GET_VALUE (fixP->fx_addsy) + *valP);
+	  bfd_putl16 (bfd_getl16 (buf) | delta, buf);
+	}
+      break;
+
+    case BFD_RELOC_RISCV_RVC_JUMP:
+      if (fixP->fx_addsy)
+	{
+	  /* Fill in a tentative value to improve objdump readability.  */
+	  bfd_vma delta = ENCODE_RVC_J_IMM (S_GET_VALUE (fixP->fx_addsy) + *valP);
+	  bfd_putl16 (bfd_getl16 (buf) | delta, buf);
+	}
+      break;
+
     case BFD_RELOC_RISCV_PCREL_LO12_S:
     case BFD_RELOC_RISCV_PCREL_LO12_I:
     case BFD_RELOC_RISCV_CALL:
@@ -1904,9 +2431,9 @@ s_riscv_option (int x ATTRIBUTE_UNUSED)
   *input_line_pointer = '\0';
 
   if (strcmp (name, "rvc") == 0)
-    riscv_opts.rvc = 1;
+    riscv_set_rvc (TRUE);
   else if (strcmp (name, "norvc") == 0)
-    riscv_opts.rvc = 0;
+    riscv_set_rvc (FALSE);
   else if (strcmp (name, "push") == 0)
     {
       struct riscv_option_stack *s;
@@ -1983,6 +2510,7 @@ static void
 s_align (int x ATTRIBUTE_UNUSED)
 {
   int alignment, fill_value = 0, fill_value_specified = 0;
+  int min_insn_bits = riscv_opts.rvc ? 1 : 2;
 
   alignment = get_absolute_expression ();
   if (alignment < 0 || alignment > 31)
@@ -1995,15 +2523,19 @@ s_align (int x ATTRIBUTE_UNUSED)
       fill_value_specified = 1;
     }
 
-  if (!fill_value_specified && subseg_text_p (now_seg) && alignment > 2)
+  if (!fill_value_specified && subseg_text_p (now_seg)
+      && alignment > min_insn_bits)
     {
       /* Emit the worst-case NOP string.  The linker will delete any
          unnecessary NOPs.  This allows us to support code alignment
-         in spite of linker relaxations.  */
-      bfd_vma i, worst_case_nop_bytes = (1L << alignment) - 4;
+         in spite of linker relaxations.  With RVC the worst case is
+         two bytes short of the alignment, so end with a C.NOP.  */
+      bfd_vma i, worst_case_nop_bytes = (1L << alignment) - (1 << min_insn_bits);
       char *nops = frag_more (worst_case_nop_bytes);
-      for (i = 0; i < worst_case_nop_bytes; i += 4)
+      for (i = 0; i + 4 <= worst_case_nop_bytes; i += 4)
 	md_number_to_chars (nops + i, RISCV_NOP, 4);
+      if (i < worst_case_nop_bytes)
+	md_number_to_chars (nops + i, RVC_NOP, 2);
 
       expressionS ex;
       ex.X_op = O_constant;
@@ -2023,7 +2555,7 @@ s_align (int x ATTRIBUTE_UNUSED)
 int
 md_estimate_size_before_relax (fragS *fragp, asection *segtype)
 {
-  return (fragp->fr_var = relaxed_branch_length (fragp, segtype, FALSE));
+  return (fragp->fr_var = relaxed_branch_length (fragp, segtype, TRUE));
 }
 
 /* Translate internal representation of relocation info to BFD target
@@ -2087,6 +2619,8 @@ md_convert_frag_branch (fragS *fragp)
   insn_t insn;
   expressionS exp;
   fixS *fixp;
+  bfd_reloc_code_real_type reloc;
+  int rs1;
 
   buf = (bfd_byte *)fragp->fr_literal + fragp->fr_fix;
 
@@ -2094,32 +2628,87 @@ md_convert_frag_branch (fragS *fragp)
   exp.X_add_symbol = fragp->fr_symbol;
   exp.X_add_number = fragp->fr_offset;
 
-  if (RELAX_BRANCH_TOOFAR (fragp->fr_subtype))
+  gas_assert (fragp->fr_var == RELAX_BRANCH_LENGTH (fragp->fr_subtype));
+
+  if (RELAX_BRANCH_RVC (fragp->fr_subtype))
     {
-      gas_assert (fragp->fr_var == 8);
+      switch (RELAX_BRANCH_LENGTH (fragp->fr_subtype))
+	{
+	case 8:
+	case 4:
+	  /* Expand the RVC branch into a full-size one. */
+	  insn = bfd_getl16 (buf);
+	  rs1 = 8 + ((insn >> OP_SH_CRS1S) & OP_MASK_CRS1S);
+	  if ((insn & MASK_C_J) == MATCH_C_J)
+	    insn = MATCH_JAL;
+	  else if ((insn & MASK_C_JAL) == MATCH_C_JAL)
+	    insn = MATCH_JAL | (X_RA << OP_SH_RD);
+	  else if ((insn & MASK_C_BEQZ) == MATCH_C_BEQZ)
+	    insn = MATCH_BEQ | (rs1 << OP_SH_RS1);
+	  else if ((insn & MASK_C_BNEZ) == MATCH_C_BNEZ)
+	    insn = MATCH_BNE | (rs1 << OP_SH_RS1);
+	  else
+	    abort ();
+	  bfd_putl32 (insn, buf);
+	  break;
+
+	case 6:
+	  /* Invert the branch condition.  Branch over the jump. */
+	  insn = bfd_getl16 (buf);
+	  insn ^= MATCH_C_BEQZ ^ MATCH_C_BNEZ;
+	  insn |= ENCODE_RVC_B_IMM (6);
+	  bfd_putl16 (insn, buf);
+	  buf += 2;
+	  goto jump;
+
+	case 2:
+	  /* Just keep the RVC branch. */
+	  reloc = RELAX_BRANCH_UNCOND (fragp->fr_subtype)
+		  ? BFD_RELOC_RISCV_RVC_JUMP : BFD_RELOC_RISCV_RVC_BRANCH;
+	  fixp = fix_new_exp (fragp, buf - (bfd_byte *)fragp->fr_literal,
+			      2, &exp, FALSE, reloc);
+	  buf += 2;
+	  goto done;
+
+	default:
+	  abort ();
+	}
+    }
+
+  switch (RELAX_BRANCH_LENGTH (fragp->fr_subtype))
+    {
+    case 8:
       /* We could relax JAL to AUIPC/JALR, but we don't do this yet. */
       gas_assert (!RELAX_BRANCH_UNCOND (fragp->fr_subtype));
-      
+
       /* Invert the branch condition.  Branch over the jump. */
       insn = bfd_getl32 (buf);
       insn ^= MATCH_BEQ ^ MATCH_BNE;
       insn |= ENCODE_SBTYPE_IMM (8);
       md_number_to_chars ((char *) buf, insn, 4);
       buf += 4;
-      
+
+    jump:
       /* Jump to the target. */
       fixp = fix_new_exp (fragp, buf - (bfd_byte *)fragp->fr_literal,
 			  4, &exp, FALSE, BFD_RELOC_RISCV_JMP);
       md_number_to_chars ((char *) buf, MATCH_JAL, 4);
       buf += 4;
-    }
-  else
-    {
+      break;
+
+    case 4:
+      reloc = RELAX_BRANCH_UNCOND (fragp->fr_subtype)
+	      ? BFD_RELOC_RISCV_JMP : BFD_RELOC_12_PCREL;
       fixp = fix_new_exp (fragp, buf - (bfd_byte *)fragp->fr_literal,
-			  4, &exp, FALSE, BFD_RELOC_12_PCREL);
+			  4, &exp, FALSE, reloc);
       buf += 4;
+      break;
+
+    default:
+      abort ();
     }
 
+done:
   fixp->fx_file = fragp->fr_file;
   fixp->fx_line = fragp->fr_line;
   fixp->fx_pcrel = 1;
@@ -2150,6 +2739,8 @@ RISC-V options:\n\
   -m64           assemble RV64 code (default)\n\
   -fpic          generate position-independent code\n\
   -fno-pic       don't generate position-independent code (default)\n\
+  -mrvc          generate compressed (RVC) instructions\n\
+  -mno-rvc       don't generate compressed instructions (default)\n\
 "));
 }
 
@@ -2193,6 +2784,9 @@ riscv_elf_final_processing (void)
 
   EF_SET_RISCV_EXT(elf_elfheader (stdoutput)->e_flags,
     riscv_elf_name_to_flag (extension));
+
+  if (riscv_rvc_used)
+    elf_elfheader (stdoutput)->e_flags |= EF_RISCV_RVC;
 }
 
 /* Pseudo-op table.  */
@@ -74,10 +74,19 @@ START_RELOC_NUMBERS (elf_riscv_reloc_type)
   RELOC_NUMBER (R_RISCV_GNU_VTINHERIT, 41)
   RELOC_NUMBER (R_RISCV_GNU_VTENTRY, 42)
   RELOC_NUMBER (R_RISCV_ALIGN, 43)
+  RELOC_NUMBER (R_RISCV_RVC_BRANCH, 44)
+  RELOC_NUMBER (R_RISCV_RVC_JUMP, 45)
+  RELOC_NUMBER (R_RISCV_RVC_LUI, 46)
+
+  /* Relocation types used by the dynamic linker for STT_GNU_IFUNC.  */
+  RELOC_NUMBER (R_RISCV_IRELATIVE, 58)
 END_RELOC_NUMBERS (R_RISCV_max)
 
 /* Processor specific flags for the ELF header e_flags field.  */
 
+/* File may contain compressed instructions.  */
+#define EF_RISCV_RVC 0x0001
+
 /* Custom flag definitions. */
 
 #define EF_RISCV_EXT_MASK 0xffff
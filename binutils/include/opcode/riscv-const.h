@@ -0,0 +1,227 @@
+/* riscv-const.h.  RISC-V integer constant synthesis.
+   Copyright (C) 2015 Free Software Foundation, Inc.
+
+This file is part of GDB, GAS, and the GNU binutils.
+
+GDB, GAS, and the GNU binutils are free software; you can redistribute
+them and/or modify them under the terms of the GNU General Public
+License as published by the Free Software Foundation; either version
+1, or (at your option) any later version.
+
+GDB, GAS, and the GNU binutils are distributed in the hope that they
+will be useful, but WITHOUT ANY WARRANTY; without even the implied
+warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this file; see the file COPYING.  If not, write to the Free
+Software Foundation, 51 Franklin Street - Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+/* This file is shared by GAS, which uses it to expand the li macro,
+   and GCC, which keeps a copy in config/riscv.  It must only depend
+   on <stdint.h>, which both include before it.  */
+
+#ifndef _RISCV_CONST_H_
+#define _RISCV_CONST_H_
+
+/* The longest sequence riscv_build_const can return.  Any 64-bit value
+   can be built with LUI, ADDI and three SLLI/ADDI pairs.  */
+#define RISCV_CONST_MAX_OPS 8
+
+/* Loading a constant from .srodata.cst8 takes two instructions and a
+   memory access, so synthesizing it is preferred up to this length.  */
+#define RISCV_CONST_POOL_INSNS 3
+
+enum riscv_const_code
+{
+  /* The first operation, which sets the register to VALUE.  */
+  RISCV_CONST_LUI,
+  RISCV_CONST_ADDI,
+
+  /* Subsequent operations, which combine the register with VALUE.  */
+  RISCV_CONST_ADDIW,
+  RISCV_CONST_XORI,
+  RISCV_CONST_SLLI,
+  RISCV_CONST_SRLI
+};
+
+struct riscv_const_op
+{
+  enum riscv_const_code code;
+  int64_t value;
+};
+
+/* Sign-extend the low BITS bits of VALUE.  */
+
+static inline int64_t
+riscv_const_sext (int64_t value, int bits)
+{
+  uint64_t sign = (uint64_t) 1 << (bits - 1);
+
+  if (bits >= 64)
+    return value;
+  return (int64_t) ((((uint64_t) value & ((sign << 1) - 1)) ^ sign) - sign);
+}
+
+/* Return true if VALUE is a valid intermediate result in BITS-bit
+   registers.  */
+
+static inline int
+riscv_const_fits (int64_t value, int bits)
+{
+  return value == riscv_const_sext (value, bits);
+}
+
+static inline void
+riscv_const_copy (struct riscv_const_op *to,
+		  const struct riscv_const_op *from, int n)
+{
+  while (n-- > 0)
+    *to++ = *from++;
+}
+
+/* Fill OPS with the shortest sequence we can find that builds VALUE,
+   trying every way of ending it with ADDI, XORI, SLLI or SRLI.  Return
+   the length of the sequence, or a number greater than BUDGET if there
+   is none of at most BUDGET operations.  */
+
+static inline int
+riscv_const_search (struct riscv_const_op *ops, int64_t value, int bits,
+		    int budget)
+{
+  struct riscv_const_op alt_ops[RISCV_CONST_MAX_OPS];
+  int64_t low = riscv_const_sext (value, 12);
+  int cost = budget + 1, alt_cost, shift;
+
+  if (budget < 1)
+    return cost;
+
+  /* Simply ADDI or LUI.  */
+  if (value == low)
+    {
+      ops[0].code = RISCV_CONST_ADDI;
+      ops[0].value = value;
+      return 1;
+    }
+  if (low == 0 && riscv_const_fits (value, 32))
+    {
+      ops[0].code = RISCV_CONST_LUI;
+      ops[0].value = value;
+      return 1;
+    }
+
+  if (budget < 2)
+    return cost;
+
+  /* LUI followed by ADDI.  On RV64, a 32-bit value whose high part
+     would overflow into bit 31 uses ADDIW to wrap it back.  */
+  if (riscv_const_fits (value, 32))
+    {
+      int64_t hi = riscv_const_sext ((uint64_t) value - low, 32);
+
+      if (riscv_const_fits (hi, bits))
+	{
+	  ops[0].code = RISCV_CONST_LUI;
+	  ops[0].value = hi;
+	  ops[1].code = (bits == 64 && hi + low != value
+			 ? RISCV_CONST_ADDIW : RISCV_CONST_ADDI);
+	  ops[1].value = low;
+	  return 2;
+	}
+    }
+
+  /* End with ADDI.  */
+  if (low != 0 && riscv_const_fits (value - low, bits))
+    {
+      alt_cost = 1 + riscv_const_search (alt_ops, value - low, bits, cost - 2);
+      if (alt_cost < cost)
+	{
+	  cost = alt_cost;
+	  riscv_const_copy (ops, alt_ops, cost - 1);
+	  ops[cost - 1].code = RISCV_CONST_ADDI;
+	  ops[cost - 1].value = low;
+	}
+    }
+
+  /* End with XORI, which can flip the upper bits.  */
+  if (low < 0 && riscv_const_fits (value ^ low, bits))
+    {
+      alt_cost = 1 + riscv_const_search (alt_ops, value ^ low, bits, cost - 2);
+      if (alt_cost < cost)
+	{
+	  cost = alt_cost;
+	  riscv_const_copy (ops, alt_ops, cost - 1);
+	  ops[cost - 1].code = RISCV_CONST_XORI;
+	  ops[cost - 1].value = low;
+	}
+    }
+
+  /* Eliminate trailing zeros and end with SLLI.  */
+  if (value != 0 && (value & 1) == 0)
+    {
+      for (shift = 0; ((value >> shift) & 1) == 0; shift++)
+	continue;
+      alt_cost = 1 + riscv_const_search (alt_ops, value >> shift, bits,
+					 cost - 2);
+      if (alt_cost < cost)
+	{
+	  cost = alt_cost;
+	  riscv_const_copy (ops, alt_ops, cost - 1);
+	  ops[cost - 1].code = RISCV_CONST_SLLI;
+	  ops[cost - 1].value = shift;
+	}
+    }
+
+  /* Eliminate leading zeros and end with SRLI, filling the vacated
+     bits with either ones or zeros.  */
+  if (bits == 64 && value > 0)
+    {
+      int64_t shifted;
+
+      for (shift = 0; ((uint64_t) value << shift) >> 63 == 0; shift++)
+	continue;
+      shifted = (int64_t) ((uint64_t) value << shift);
+
+      alt_cost = 1 + riscv_const_search (alt_ops,
+					 shifted | (((int64_t) 1 << shift) - 1),
+					 bits, cost - 2);
+      if (alt_cost < cost)
+	{
+	  cost = alt_cost;
+	  riscv_const_copy (ops, alt_ops, cost - 1);
+	  ops[cost - 1].code = RISCV_CONST_SRLI;
+	  ops[cost - 1].value = shift;
+	}
+
+      alt_cost = 1 + riscv_const_search (alt_ops, shifted, bits, cost - 2);
+      if (alt_cost < cost)
+	{
+	  cost = alt_cost;
+	  riscv_const_copy (ops, alt_ops, cost - 1);
+	  ops[cost - 1].code = RISCV_CONST_SRLI;
+	  ops[cost - 1].value = shift;
+	}
+    }
+
+  return cost;
+}
+
+/* Fill OPS with a sequence of operations that loads VALUE into a
+   BITS-bit register and return its length, or return 0 if there is
+   no sequence of at most RISCV_CONST_MAX_OPS operations.
+
+   BITS is 64 for RV64 registers and 32 for RV32 registers and for
+   RV64 32-bit operations, where arithmetic wraps at bit 31.  Smaller
+   BITS require every intermediate result to fit without wrapping.  */
+
+static inline int
+riscv_build_const (struct riscv_const_op *ops, int64_t value, int bits)
+{
+  int cost;
+
+  value = riscv_const_sext (value, bits < 32 ? 32 : bits);
+  cost = riscv_const_search (ops, value, bits, RISCV_CONST_MAX_OPS);
+  return cost <= RISCV_CONST_MAX_OPS ? cost : 0;
+}
+
+#endif /* _RISCV_CONST_H_ */
@@ -5,32 +5,22 @@
 #define MASK_CUSTOM3_RD_RS1_RS2  0x707f
 #define MATCH_VLSEGSTWU 0xc00305b
 #define MASK_VLSEGSTWU  0x1e00707f
-#define MATCH_C_LW0 0x12
-#define MASK_C_LW0  0x801f
 #define MATCH_FMV_D_X 0xf2000053
 #define MASK_FMV_D_X  0xfff0707f
 #define MATCH_VLH 0x200205b
 #define MASK_VLH  0xfff0707f
-#define MATCH_C_LI 0x0
-#define MASK_C_LI  0x1f
 #define MATCH_FADD_D 0x2000053
 #define MASK_FADD_D  0xfe00007f
-#define MATCH_C_LD 0x9
-#define MASK_C_LD  0x1f
 #define MATCH_VLD 0x600205b
 #define MASK_VLD  0xfff0707f
 #define MATCH_FADD_S 0x53
 #define MASK_FADD_S  0xfe00007f
-#define MATCH_C_LW 0xa
-#define MASK_C_LW  0x1f
 #define MATCH_VLW 0x400205b
 #define MASK_VLW  0xfff0707f
 #define MATCH_VSSEGSTW 0x400307b
 #define MASK_VSSEGSTW  0x1e00707f
 #define MATCH_UTIDX 0x6077
 #define MASK_UTIDX  0xfffff07f
-#define MATCH_C_FLW 0x14
-#define MASK_C_FLW  0x1f
 #define MATCH_FSUB_D 0xa000053
 #define MASK_FSUB_D  0xfe00007f
 #define MATCH_VSSEGSTD 0x600307b
@@ -41,14 +31,10 @@
 #define MASK_DIV  0xfe00707f
 #define MATCH_FMV_H_X 0xf4000053
 #define MASK_FMV_H_X  0xfff0707f
-#define MATCH_C_FLD 0x15
-#define MASK_C_FLD  0x1f
 #define MATCH_FRRM 0x202073
 #define MASK_FRRM  0xfffff07f
 #define MATCH_VFMSV_S 0x1000202b
 #define MASK_VFMSV_S  0xfff0707f
-#define MATCH_C_LWSP 0x5
-#define MASK_C_LWSP  0x1f
 #define MATCH_FENCE 0xf
 #define MASK_FENCE  0x707f
 #define MATCH_FNMSUB_S 0x4b
@@ -107,8 +93,6 @@
 #define MASK_VENQIMM2  0xfe007fff
 #define MATCH_RDINSTRET 0xc0202073
 #define MASK_RDINSTRET  0xfffff07f
-#define MATCH_C_SWSP 0x8
-#define MASK_C_SWSP  0x1f
 #define MATCH_VLSTW 0x400305b
 #define MASK_VLSTW  0xfe00707f
 #define MATCH_VLSTH 0x200305b
@@ -135,8 +119,6 @@
 #define MASK_FNMADD_D  0x600007f
 #define MATCH_FCVT_W_S 0xc0000053
 #define MASK_FCVT_W_S  0xfff0007f
-#define MATCH_C_SRAI 0x1019
-#define MASK_C_SRAI  0x1c1f
 #define MATCH_MULHSU 0x2002033
 #define MASK_MULHSU  0xfe00707f
 #define MATCH_FCVT_D_LU 0xd2300053
@@ -281,16 +263,12 @@
 #define MASK_FSFLAGS  0xfff0707f
 #define MATCH_SRLI 0x5013
 #define MASK_SRLI  0xfc00707f
-#define MATCH_C_SRLI 0x819
-#define MASK_C_SRLI  0x1c1f
 #define MATCH_AMOMINU_W 0xc000202f
 #define MASK_AMOMINU_W  0xf800707f
 #define MATCH_SRLW 0x503b
 #define MASK_SRLW  0xfe00707f
 #define MATCH_VFLSEGW 0x1400205b
 #define MASK_VFLSEGW  0x1ff0707f
-#define MATCH_C_LD0 0x8012
-#define MASK_C_LD0  0x801f
 #define MATCH_VLSEGBU 0x800205b
 #define MASK_VLSEGBU  0x1ff0707f
 #define MATCH_JALR 0x67
@@ -343,14 +321,10 @@
 #define MASK_AMOMAXU_W  0xf800707f
 #define MATCH_SRAI_RV32 0x40005013
 #define MASK_SRAI_RV32  0xfe00707f
-#define MATCH_C_SRLI32 0xc19
-#define MASK_C_SRLI32  0x1c1f
 #define MATCH_VFSSTW 0x1400307b
 #define MASK_VFSSTW  0xfe00707f
 #define MATCH_CUSTOM0_RD 0x400b
 #define MASK_CUSTOM0_RD  0x707f
-#define MATCH_C_BEQ 0x10
-#define MASK_C_BEQ  0x1f
 #define MATCH_VFSSTD 0x1600307b
 #define MASK_VFSSTD  0xfe00707f
 #define MATCH_CUSTOM3_RD_RS1 0x607b
@@ -377,14 +351,10 @@
 #define MASK_FSGNJ_S  0xfe00707f
 #define MATCH_FMSUB_S 0x47
 #define MASK_FMSUB_S  0x600007f
-#define MATCH_C_SUB3 0x11c
-#define MASK_C_SUB3  0x31f
 #define MATCH_FSGNJ_H 0x2c000053
 #define MASK_FSGNJ_H  0xfe00707f
 #define MATCH_VLB 0x205b
 #define MASK_VLB  0xfff0707f
-#define MATCH_C_ADDIW 0x1d
-#define MASK_C_ADDIW  0x1f
 #define MATCH_CUSTOM3_RS1_RS2 0x307b
 #define MASK_CUSTOM3_RS1_RS2  0x707f
 #define MATCH_FSGNJ_D 0x22000053
@@ -417,14 +387,8 @@
 #define MASK_REMUW  0xfe00707f
 #define MATCH_JAL 0x6f
 #define MASK_JAL  0x7f
-#define MATCH_C_FSD 0x18
-#define MASK_C_FSD  0x1f
 #define MATCH_RDCYCLE 0xc0002073
 #define MASK_RDCYCLE  0xfffff07f
-#define MATCH_C_BNE 0x11
-#define MASK_C_BNE  0x1f
-#define MATCH_C_ADD 0x1a
-#define MASK_C_ADD  0x801f
 #define MATCH_VXCPTCAUSE 0x402b
 #define MASK_VXCPTCAUSE  0xfffff07f
 #define MATCH_VGETCFG 0x400b
@@ -433,10 +397,6 @@
 #define MASK_LUI  0x7f
 #define MATCH_VSETCFG 0x200b
 #define MASK_VSETCFG  0x7fff
-#define MATCH_C_SDSP 0x6
-#define MASK_C_SDSP  0x1f
-#define MATCH_C_LDSP 0x4
-#define MASK_C_LDSP  0x1f
 #define MATCH_FNMADD_H 0x400004f
 #define MASK_FNMADD_H  0x600007f
 #define MATCH_CUSTOM0_RS1_RS2 0x300b
@@ -447,8 +407,6 @@
 #define MASK_MUL  0xfe00707f
 #define MATCH_CSRRCI 0x7073
 #define MASK_CSRRCI  0x707f
-#define MATCH_C_SRAI32 0x1419
-#define MASK_C_SRAI32  0x1c1f
 #define MATCH_FLT_H 0xb4000053
 #define MASK_FLT_H  0xfe00707f
 #define MATCH_SRAI 0x40005013
@@ -477,8 +435,6 @@
 #define MASK_FCVT_D_L  0xfff0007f
 #define MATCH_FCVT_WU_H 0x5c000053
 #define MASK_FCVT_WU_H  0xfff0007f
-#define MATCH_C_SLLI 0x19
-#define MASK_C_SLLI  0x1c1f
 #define MATCH_AMOXOR_D 0x2000302f
 #define MASK_AMOXOR_D  0xf800707f
 #define MATCH_FCVT_WU_S 0xc0100053
@@ -493,14 +449,6 @@
 #define MASK_VLBU  0xfff0707f
 #define MATCH_VLHU 0xa00205b
 #define MASK_VLHU  0xfff0707f
-#define MATCH_C_SW 0xd
-#define MASK_C_SW  0x1f
-#define MATCH_C_SD 0xc
-#define MASK_C_SD  0x1f
-#define MATCH_C_OR3 0x21c
-#define MASK_C_OR3  0x31f
-#define MATCH_C_AND3 0x31c
-#define MASK_C_AND3  0x31f
 #define MATCH_VFSSEGSTW 0x1400307b
 #define MASK_VFSSEGSTW  0x1e00707f
 #define MATCH_SLT 0x2033
@@ -647,12 +595,8 @@
 #define MASK_AMOADD_D  0xf800707f
 #define MATCH_AMOMAX_W 0xa000202f
 #define MASK_AMOMAX_W  0xf800707f
-#define MATCH_C_MOVE 0x2
-#define MASK_C_MOVE  0x801f
 #define MATCH_FMOVN 0x6007077
 #define MASK_FMOVN  0xfe00707f
-#define MATCH_C_FSW 0x16
-#define MASK_C_FSW  0x1f
 #define MATCH_AMOADD_W 0x202f
 #define MASK_AMOADD_W  0xf800707f
 #define MATCH_AMOMAX_D 0xa000302f
@@ -667,10 +611,6 @@
 #define MASK_VSD  0xfff0707f
 #define MATCH_VLSEGSTW 0x400305b
 #define MASK_VLSEGSTW  0x1e00707f
-#define MATCH_C_ADDI 0x1
-#define MASK_C_ADDI  0x1f
-#define MATCH_C_SLLIW 0x1819
-#define MASK_C_SLLIW  0x1c1f
 #define MATCH_VLSEGSTB 0x305b
 #define MASK_VLSEGSTB  0x1e00707f
 #define MATCH_VLSEGSTD 0x600305b
@@ -681,10 +621,6 @@
 #define MASK_MULHU  0xfe00707f
 #define MATCH_AMOMIN_W 0x8000202f
 #define MASK_AMOMIN_W  0xf800707f
-#define MATCH_C_SLLI32 0x419
-#define MASK_C_SLLI32  0x1c1f
-#define MATCH_C_ADD3 0x1c
-#define MASK_C_ADD3  0x31f
 #define MATCH_VGETVL 0x200400b
 #define MASK_VGETVL  0xfffff07f
 #define MATCH_AMOMIN_D 0x8000302f
@@ -701,14 +637,94 @@
 #define MASK_FSH  0x707f
 #define MATCH_VLSEGH 0x200205b
 #define MASK_VLSEGH  0x1ff0707f
-#define MATCH_C_SUB 0x801a
-#define MASK_C_SUB  0x801f
 #define MATCH_VLSEGW 0x400205b
 #define MASK_VLSEGW  0x1ff0707f
 #define MATCH_FSW 0x2027
 #define MASK_FSW  0x707f
-#define MATCH_C_J 0x8002
-#define MASK_C_J  0x801f
+#define MATCH_C_NOP 0x1
+#define MASK_C_NOP  0xffff
+#define MATCH_C_ADDI16SP 0x6101
+#define MASK_C_ADDI16SP  0xef83
+#define MATCH_C_JR 0x8002
+#define MASK_C_JR  0xf07f
+#define MATCH_C_JALR 0x9002
+#define MASK_C_JALR  0xf07f
+#define MATCH_C_EBREAK 0x9002
+#define MASK_C_EBREAK  0xffff
+#define MATCH_C_LD 0x6000
+#define MASK_C_LD  0xe003
+#define MATCH_C_SD 0xe000
+#define MASK_C_SD  0xe003
+#define MATCH_C_ADDIW 0x2001
+#define MASK_C_ADDIW  0xe003
+#define MATCH_C_LDSP 0x6002
+#define MASK_C_LDSP  0xe003
+#define MATCH_C_SDSP 0xe002
+#define MASK_C_SDSP  0xe003
+#define MATCH_C_ADDI4SPN 0x0
+#define MASK_C_ADDI4SPN  0xe003
+#define MATCH_C_FLD 0x2000
+#define MASK_C_FLD  0xe003
+#define MATCH_C_LW 0x4000
+#define MASK_C_LW  0xe003
+#define MATCH_C_FLW 0x6000
+#define MASK_C_FLW  0xe003
+#define MATCH_C_FSD 0xa000
+#define MASK_C_FSD  0xe003
+#define MATCH_C_SW 0xc000
+#define MASK_C_SW  0xe003
+#define MATCH_C_FSW 0xe000
+#define MASK_C_FSW  0xe003
+#define MATCH_C_ADDI 0x1
+#define MASK_C_ADDI  0xe003
+#define MATCH_C_JAL 0x2001
+#define MASK_C_JAL  0xe003
+#define MATCH_C_LI 0x4001
+#define MASK_C_LI  0xe003
+#define MATCH_C_LUI 0x6001
+#define MASK_C_LUI  0xe003
+#define MATCH_C_SRLI 0x8001
+#define MASK_C_SRLI  0xec03
+#define MATCH_C_SRAI 0x8401
+#define MASK_C_SRAI  0xec03
+#define MATCH_C_ANDI 0x8801
+#define MASK_C_ANDI  0xec03
+#define MATCH_C_SUB 0x8c01
+#define MASK_C_SUB  0xfc63
+#define MATCH_C_XOR 0x8c21
+#define MASK_C_XOR  0xfc63
+#define MATCH_C_OR 0x8c41
+#define MASK_C_OR  0xfc63
+#define MATCH_C_AND 0x8c61
+#define MASK_C_AND  0xfc63
+#define MATCH_C_SUBW 0x9c01
+#define MASK_C_SUBW  0xfc63
+#define MATCH_C_ADDW 0x9c21
+#define MASK_C_ADDW  0xfc63
+#define MATCH_C_J 0xa001
+#define MASK_C_J  0xe003
+#define MATCH_C_BEQZ 0xc001
+#define MASK_C_BEQZ  0xe003
+#define MATCH_C_BNEZ 0xe001
+#define MASK_C_BNEZ  0xe003
+#define MATCH_C_SLLI 0x2
+#define MASK_C_SLLI  0xe003
+#define MATCH_C_FLDSP 0x2002
+#define MASK_C_FLDSP  0xe003
+#define MATCH_C_LWSP 0x4002
+#define MASK_C_LWSP  0xe003
+#define MATCH_C_FLWSP 0x6002
+#define MASK_C_FLWSP  0xe003
+#define MATCH_C_MV 0x8002
+#define MASK_C_MV  0xf003
+#define MATCH_C_ADD 0x9002
+#define MASK_C_ADD  0xf003
+#define MATCH_C_FSDSP 0xa002
+#define MASK_C_FSDSP  0xe003
+#define MATCH_C_SWSP 0xc002
+#define MASK_C_SWSP  0xe003
+#define MATCH_C_FSWSP 0xe002
+#define MASK_C_FSWSP  0xe003
 #define CSR_FFLAGS 0x1
 #define CSR_FRM 0x2
 #define CSR_FCSR 0x3
@@ -771,28 +787,21 @@
 #ifdef DECLARE_INSN
 DECLARE_INSN(custom3_rd_rs1_rs2, MATCH_CUSTOM3_RD_RS1_RS2, MASK_CUSTOM3_RD_RS1_RS2)
 DECLARE_INSN(vlsegstwu, MATCH_VLSEGSTWU, MASK_VLSEGSTWU)
-DECLARE_INSN(c_lw0, MATCH_C_LW0, MASK_C_LW0)
 DECLARE_INSN(fmv_d_x, MATCH_FMV_D_X, MASK_FMV_D_X)
 DECLARE_INSN(vlh, MATCH_VLH, MASK_VLH)
-DECLARE_INSN(c_li, MATCH_C_LI, MASK_C_LI)
 DECLARE_INSN(fadd_d, MATCH_FADD_D, MASK_FADD_D)
-DECLARE_INSN(c_ld, MATCH_C_LD, MASK_C_LD)
 DECLARE_INSN(vld, MATCH_VLD, MASK_VLD)
 DECLARE_INSN(fadd_s, MATCH_FADD_S, MASK_FADD_S)
-DECLARE_INSN(c_lw, MATCH_C_LW, MASK_C_LW)
 DECLARE_INSN(vlw, MATCH_VLW, MASK_VLW)
 DECLARE_INSN(vssegstw, MATCH_VSSEGSTW, MASK_VSSEGSTW)
 DECLARE_INSN(utidx, MATCH_UTIDX, MASK_UTIDX)
-DECLARE_INSN(c_flw, MATCH_C_FLW, MASK_C_FLW)
 DECLARE_INSN(fsub_d, MATCH_FSUB_D, MASK_FSUB_D)
 DECLARE_INSN(vssegstd, MATCH_VSSEGSTD, MASK_VSSEGSTD)
 DECLARE_INSN(vssegstb, MATCH_VSSEGSTB, MASK_VSSEGSTB)
 DECLARE_INSN(div, MATCH_DIV, MASK_DIV)
 DECLARE_INSN(fmv_h_x, MATCH_FMV_H_X, MASK_FMV_H_X)
-DECLARE_INSN(c_fld, MATCH_C_FLD, MASK_C_FLD)
 DECLARE_INSN(frrm, MATCH_FRRM, MASK_FRRM)
 DECLARE_INSN(vfmsv_s, MATCH_VFMSV_S, MASK_VFMSV_S)
-DECLARE_INSN(c_lwsp, MATCH_C_LWSP, MASK_C_LWSP)
 DECLARE_INSN(fence, MATCH_FENCE, MASK_FENCE)
 DECLARE_INSN(fnmsub_s, MATCH_FNMSUB_S, MASK_FNMSUB_S)
 DECLARE_INSN(fle_s, MATCH_FLE_S, MASK_FLE_S)
@@ -822,7 +831,6 @@ DECLARE_INSN(custom1_rd_rs1_rs2, MATCH_CUSTOM1_RD_RS1_RS2, MASK_CUSTOM1_RD_RS1_R
 DECLARE_INSN(venqimm1, MATCH_VENQIMM1, MASK_VENQIMM1)
 DECLARE_INSN(venqimm2, MATCH_VENQIMM2, MASK_VENQIMM2)
 DECLARE_INSN(rdinstret, MATCH_RDINSTRET, MASK_RDINSTRET)
-DECLARE_INSN(c_swsp, MATCH_C_SWSP, MASK_C_SWSP)
 DECLARE_INSN(vlstw, MATCH_VLSTW, MASK_VLSTW)
 DECLARE_INSN(vlsth, MATCH_VLSTH, MASK_VLSTH)
 DECLARE_INSN(vlstb, MATCH_VLSTB, MASK_VLSTB)
@@ -836,7 +844,6 @@ DECLARE_INSN(custom0_rs1, MATCH_CUSTOM0_RS1, MASK_CUSTOM0_RS1)
 DECLARE_INSN(vlsegstbu, MATCH_VLSEGSTBU, MASK_VLSEGSTBU)
 DECLARE_INSN(fnmadd_d, MATCH_FNMADD_D, MASK_FNMADD_D)
 DECLARE_INSN(fcvt_w_s, MATCH_FCVT_W_S, MASK_FCVT_W_S)
-DECLARE_INSN(c_srai, MATCH_C_SRAI, MASK_C_SRAI)
 DECLARE_INSN(mulhsu, MATCH_MULHSU, MASK_MULHSU)
 DECLARE_INSN(fcvt_d_lu, MATCH_FCVT_D_LU, MASK_FCVT_D_LU)
 DECLARE_INSN(fcvt_w_d, MATCH_FCVT_W_D, MASK_FCVT_W_D)
@@ -909,11 +916,9 @@ DECLARE_INSN(vxcptevac, MATCH_VXCPTEVAC, MASK_VXCPTEVAC)
 DECLARE_INSN(amominu_d, MATCH_AMOMINU_D, MASK_AMOMINU_D)
 DECLARE_INSN(fsflags, MATCH_FSFLAGS, MASK_FSFLAGS)
 DECLARE_INSN(srli, MATCH_SRLI, MASK_SRLI)
-DECLARE_INSN(c_srli, MATCH_C_SRLI, MASK_C_SRLI)
 DECLARE_INSN(amominu_w, MATCH_AMOMINU_W, MASK_AMOMINU_W)
 DECLARE_INSN(srlw, MATCH_SRLW, MASK_SRLW)
 DECLARE_INSN(vflsegw, MATCH_VFLSEGW, MASK_VFLSEGW)
-DECLARE_INSN(c_ld0, MATCH_C_LD0, MASK_C_LD0)
 DECLARE_INSN(vlsegbu, MATCH_VLSEGBU, MASK_VLSEGBU)
 DECLARE_INSN(jalr, MATCH_JALR, MASK_JALR)
 DECLARE_INSN(blt, MATCH_BLT, MASK_BLT)
@@ -940,10 +945,8 @@ DECLARE_INSN(amomaxu_d, MATCH_AMOMAXU_D, MASK_AMOMAXU_D)
 DECLARE_INSN(divw, MATCH_DIVW, MASK_DIVW)
 DECLARE_INSN(amomaxu_w, MATCH_AMOMAXU_W, MASK_AMOMAXU_W)
 DECLARE_INSN(srai_rv32, MATCH_SRAI_RV32, MASK_SRAI_RV32)
-DECLARE_INSN(c_srli32, MATCH_C_SRLI32, MASK_C_SRLI32)
 DECLARE_INSN(vfsstw, MATCH_VFSSTW, MASK_VFSSTW)
 DECLARE_INSN(custom0_rd, MATCH_CUSTOM0_RD, MASK_CUSTOM0_RD)
-DECLARE_INSN(c_beq, MATCH_C_BEQ, MASK_C_BEQ)
 DECLARE_INSN(vfsstd, MATCH_VFSSTD, MASK_VFSSTD)
 DECLARE_INSN(custom3_rd_rs1, MATCH_CUSTOM3_RD_RS1, MASK_CUSTOM3_RD_RS1)
 DECLARE_INSN(lr_d, MATCH_LR_D, MASK_LR_D)
@@ -957,10 +960,8 @@ DECLARE_INSN(and, MATCH_AND, MASK_AND)
 DECLARE_INSN(lbu, MATCH_LBU, MASK_LBU)
 DECLARE_INSN(fsgnj_s, MATCH_FSGNJ_S, MASK_FSGNJ_S)
 DECLARE_INSN(fmsub_s, MATCH_FMSUB_S, MASK_FMSUB_S)
-DECLARE_INSN(c_sub3, MATCH_C_SUB3, MASK_C_SUB3)
 DECLARE_INSN(fsgnj_h, MATCH_FSGNJ_H, MASK_FSGNJ_H)
 DECLARE_INSN(vlb, MATCH_VLB, MASK_VLB)
-DECLARE_INSN(c_addiw, MATCH_C_ADDIW, MASK_C_ADDIW)
 DECLARE_INSN(custom3_rs1_rs2, MATCH_CUSTOM3_RS1_RS2, MASK_CUSTOM3_RS1_RS2)
 DECLARE_INSN(fsgnj_d, MATCH_FSGNJ_D, MASK_FSGNJ_D)
 DECLARE_INSN(vlsegwu, MATCH_VLSEGWU, MASK_VLSEGWU)
@@ -977,22 +978,16 @@ DECLARE_INSN(sd, MATCH_SD, MASK_SD)
 DECLARE_INSN(fmv_s_x, MATCH_FMV_S_X, MASK_FMV_S_X)
 DECLARE_INSN(remuw, MATCH_REMUW, MASK_REMUW)
 DECLARE_INSN(jal, MATCH_JAL, MASK_JAL)
-DECLARE_INSN(c_fsd, MATCH_C_FSD, MASK_C_FSD)
 DECLARE_INSN(rdcycle, MATCH_RDCYCLE, MASK_RDCYCLE)
-DECLARE_INSN(c_bne, MATCH_C_BNE, MASK_C_BNE)
-DECLARE_INSN(c_add, MATCH_C_ADD, MASK_C_ADD)
 DECLARE_INSN(vxcptcause, MATCH_VXCPTCAUSE, MASK_VXCPTCAUSE)
 DECLARE_INSN(vgetcfg, MATCH_VGETCFG, MASK_VGETCFG)
 DECLARE_INSN(lui, MATCH_LUI, MASK_LUI)
 DECLARE_INSN(vsetcfg, MATCH_VSETCFG, MASK_VSETCFG)
-DECLARE_INSN(c_sdsp, MATCH_C_SDSP, MASK_C_SDSP)
-DECLARE_INSN(c_ldsp, MATCH_C_LDSP, MASK_C_LDSP)
 DECLARE_INSN(fnmadd_h, MATCH_FNMADD_H, MASK_FNMADD_H)
 DECLARE_INSN(custom0_rs1_rs2, MATCH_CUSTOM0_RS1_RS2, MASK_CUSTOM0_RS1_RS2)
 DECLARE_INSN(slli_rv32, MATCH_SLLI_RV32, MASK_SLLI_RV32)
 DECLARE_INSN(mul, MATCH_MUL, MASK_MUL)
 DECLARE_INSN(csrrci, MATCH_CSRRCI, MASK_CSRRCI)
-DECLARE_INSN(c_srai32, MATCH_C_SRAI32, MASK_C_SRAI32)
 DECLARE_INSN(flt_h, MATCH_FLT_H, MASK_FLT_H)
 DECLARE_INSN(srai, MATCH_SRAI, MASK_SRAI)
 DECLARE_INSN(amoand_d, MATCH_AMOAND_D, MASK_AMOAND_D)
@@ -1007,7 +1002,6 @@ DECLARE_INSN(fcvt_wu_d, MATCH_FCVT_WU_D, MASK_FCVT_WU_D)
 DECLARE_INSN(amoxor_w, MATCH_AMOXOR_W, MASK_AMOXOR_W)
 DECLARE_INSN(fcvt_d_l, MATCH_FCVT_D_L, MASK_FCVT_D_L)
 DECLARE_INSN(fcvt_wu_h, MATCH_FCVT_WU_H, MASK_FCVT_WU_H)
-DECLARE_INSN(c_slli, MATCH_C_SLLI, MASK_C_SLLI)
 DECLARE_INSN(amoxor_d, MATCH_AMOXOR_D, MASK_AMOXOR_D)
 DECLARE_INSN(fcvt_wu_s, MATCH_FCVT_WU_S, MASK_FCVT_WU_S)
 DECLARE_INSN(custom3_rd, MATCH_CUSTOM3_RD, MASK_CUSTOM3_RD)
@@ -1015,10 +1009,6 @@ DECLARE_INSN(fmax_h, MATCH_FMAX_H, MASK_FMAX_H)
 DECLARE_INSN(venqcnt, MATCH_VENQCNT, MASK_VENQCNT)
 DECLARE_INSN(vlbu, MATCH_VLBU, MASK_VLBU)
 DECLARE_INSN(vlhu, MATCH_VLHU, MASK_VLHU)
-DECLARE_INSN(c_sw, MATCH_C_SW, MASK_C_SW)
-DECLARE_INSN(c_sd, MATCH_C_SD, MASK_C_SD)
-DECLARE_INSN(c_or3, MATCH_C_OR3, MASK_C_OR3)
-DECLARE_INSN(c_and3, MATCH_C_AND3, MASK_C_AND3)
 DECLARE_INSN(vfssegstw, MATCH_VFSSEGSTW, MASK_VFSSEGSTW)
 DECLARE_INSN(slt, MATCH_SLT, MASK_SLT)
 DECLARE_INSN(amoor_d, MATCH_AMOOR_D, MASK_AMOOR_D)
@@ -1092,9 +1082,7 @@ DECLARE_INSN(fmv_x_d, MATCH_FMV_X_D, MASK_FMV_X_D)
 DECLARE_INSN(rdtime, MATCH_RDTIME, MASK_RDTIME)
 DECLARE_INSN(amoadd_d, MATCH_AMOADD_D, MASK_AMOADD_D)
 DECLARE_INSN(amomax_w, MATCH_AMOMAX_W, MASK_AMOMAX_W)
-DECLARE_INSN(c_move, MATCH_C_MOVE, MASK_C_MOVE)
 DECLARE_INSN(fmovn, MATCH_FMOVN, MASK_FMOVN)
-DECLARE_INSN(c_fsw, MATCH_C_FSW, MASK_C_FSW)
 DECLARE_INSN(amoadd_w, MATCH_AMOADD_W, MASK_AMOADD_W)
 DECLARE_INSN(amomax_d, MATCH_AMOMAX_D, MASK_AMOMAX_D)
 DECLARE_INSN(fmovz, MATCH_FMOVZ, MASK_FMOVZ)
@@ -1102,15 +1090,11 @@ DECLARE_INSN(custom1_rs1_rs2, MATCH_CUSTOM1_RS1_RS2, MASK_CUSTOM1_RS1_RS2)
 DECLARE_INSN(fmv_x_h, MATCH_FMV_X_H, MASK_FMV_X_H)
 DECLARE_INSN(vsd, MATCH_VSD, MASK_VSD)
 DECLARE_INSN(vlsegstw, MATCH_VLSEGSTW, MASK_VLSEGSTW)
-DECLARE_INSN(c_addi, MATCH_C_ADDI, MASK_C_ADDI)
-DECLARE_INSN(c_slliw, MATCH_C_SLLIW, MASK_C_SLLIW)
 DECLARE_INSN(vlsegstb, MATCH_VLSEGSTB, MASK_VLSEGSTB)
 DECLARE_INSN(vlsegstd, MATCH_VLSEGSTD, MASK_VLSEGSTD)
 DECLARE_INSN(vlsegsth, MATCH_VLSEGSTH, MASK_VLSEGSTH)
 DECLARE_INSN(mulhu, MATCH_MULHU, MASK_MULHU)
 DECLARE_INSN(amomin_w, MATCH_AMOMIN_W, MASK_AMOMIN_W)
-DECLARE_INSN(c_slli32, MATCH_C_SLLI32, MASK_C_SLLI32)
-DECLARE_INSN(c_add3, MATCH_C_ADD3, MASK_C_ADD3)
 DECLARE_INSN(vgetvl, MATCH_VGETVL, MASK_VGETVL)
 DECLARE_INSN(amomin_d, MATCH_AMOMIN_D, MASK_AMOMIN_D)
 DECLARE_INSN(fcvt_w_h, MATCH_FCVT_W_H, MASK_FCVT_W_H)
@@ -1119,10 +1103,50 @@ DECLARE_INSN(fsd, MATCH_FSD, MASK_FSD)
 DECLARE_INSN(vlsegd, MATCH_VLSEGD, MASK_VLSEGD)
 DECLARE_INSN(fsh, MATCH_FSH, MASK_FSH)
 DECLARE_INSN(vlsegh, MATCH_VLSEGH, MASK_VLSEGH)
-DECLARE_INSN(c_sub, MATCH_C_SUB, MASK_C_SUB)
 DECLARE_INSN(vlsegw, MATCH_VLSEGW, MASK_VLSEGW)
 DECLARE_INSN(fsw, MATCH_FSW, MASK_FSW)
+DECLARE_INSN(c_nop, MATCH_C_NOP, MASK_C_NOP)
+DECLARE_INSN(c_addi16sp, MATCH_C_ADDI16SP, MASK_C_ADDI16SP)
+DECLARE_INSN(c_jr, MATCH_C_JR, MASK_C_JR)
+DECLARE_INSN(c_jalr, MATCH_C_JALR, MASK_C_JALR)
+DECLARE_INSN(c_ebreak, MATCH_C_EBREAK, MASK_C_EBREAK)
+DECLARE_INSN(c_ld, MATCH_C_LD, MASK_C_LD)
+DECLARE_INSN(c_sd, MATCH_C_SD, MASK_C_SD)
+DECLARE_INSN(c_addiw, MATCH_C_ADDIW, MASK_C_ADDIW)
+DECLARE_INSN(c_ldsp, MATCH_C_LDSP, MASK_C_LDSP)
+DECLARE_INSN(c_sdsp, MATCH_C_SDSP, MASK_C_SDSP)
+DECLARE_INSN(c_addi4spn, MATCH_C_ADDI4SPN, MASK_C_ADDI4SPN)
+DECLARE_INSN(c_fld, MATCH_C_FLD, MASK_C_FLD)
+DECLARE_INSN(c_lw, MATCH_C_LW, MASK_C_LW)
+DECLARE_INSN(c_flw, MATCH_C_FLW, MASK_C_FLW)
+DECLARE_INSN(c_fsd, MATCH_C_FSD, MASK_C_FSD)
+DECLARE_INSN(c_sw, MATCH_C_SW, MASK_C_SW)
+DECLARE_INSN(c_fsw, MATCH_C_FSW, MASK_C_FSW)
+DECLARE_INSN(c_addi, MATCH_C_ADDI, MASK_C_ADDI)
+DECLARE_INSN(c_jal, MATCH_C_JAL, MASK_C_JAL)
+DECLARE_INSN(c_li, MATCH_C_LI, MASK_C_LI)
+DECLARE_INSN(c_lui, MATCH_C_LUI, MASK_C_LUI)
+DECLARE_INSN(c_srli, MATCH_C_SRLI, MASK_C_SRLI)
+DECLARE_INSN(c_srai, MATCH_C_SRAI, MASK_C_SRAI)
+DECLARE_INSN(c_andi, MATCH_C_ANDI, MASK_C_ANDI)
+DECLARE_INSN(c_sub, MATCH_C_SUB, MASK_C_SUB)
+DECLARE_INSN(c_xor, MATCH_C_XOR, MASK_C_XOR)
+DECLARE_INSN(c_or, MATCH_C_OR, MASK_C_OR)
+DECLARE_INSN(c_and, MATCH_C_AND, MASK_C_AND)
+DECLARE_INSN(c_subw, MATCH_C_SUBW, MASK_C_SUBW)
+DECLARE_INSN(c_addw, MATCH_C_ADDW, MASK_C_ADDW)
 DECLARE_INSN(c_j, MATCH_C_J, MASK_C_J)
+DECLARE_INSN(c_beqz, MATCH_C_BEQZ, MASK_C_BEQZ)
+DECLARE_INSN(c_bnez, MATCH_C_BNEZ, MASK_C_BNEZ)
+DECLARE_INSN(c_slli, MATCH_C_SLLI, MASK_C_SLLI)
+DECLARE_INSN(c_fldsp, MATCH_C_FLDSP, MASK_C_FLDSP)
+DECLARE_INSN(c_lwsp, MATCH_C_LWSP, MASK_C_LWSP)
+DECLARE_INSN(c_flwsp, MATCH_C_FLWSP, MASK_C_FLWSP)
+DECLARE_INSN(c_mv, MATCH_C_MV, MASK_C_MV)
+DECLARE_INSN(c_add, MATCH_C_ADD, MASK_C_ADD)
+DECLARE_INSN(c_fsdsp, MATCH_C_FSDSP, MASK_C_FSDSP)
+DECLARE_INSN(c_swsp, MATCH_C_SWSP, MASK_C_SWSP)
+DECLARE_INSN(c_fswsp, MATCH_C_FSWSP, MASK_C_FSWSP)
 #endif
 #ifdef DECLARE_CSR
 DECLARE_CSR(fflags, CSR_FFLAGS)
@@ -24,6 +24,7 @@
 #include "sysdep.h"
 #include "dis-asm.h"
 #include "libiberty.h"
+#include "hashtab.h"
 #include "opcode/riscv.h"
 #include "opintl.h"
 #include "elf-bfd.h"
@@ -32,59 +33,206 @@
 #include <stdint.h>
 #include <assert.h>
 
+/* The bits of an instruction that select its bucket of candidate
+   opcodes: the major opcode, funct3 and funct7 for 32-bit instructions,
+   and the quadrant and funct3 for compressed ones.  */
+#define OP_KEY_MASK_32 (OP_MASK_OP | 0x7000 | 0xfe000000)
+#define OP_KEY_MASK_16 0xe003
+
+/* The opcodes that might match an instruction with the given key bits,
+   in the order they appear in riscv_opcodes.  */
+
+struct riscv_dis_bucket
+{
+  insn_t key;
+  const struct riscv_opcode **ops;
+};
+
+/* Everything the disassembler knows about one disassemble_info.  Keeping
+   this out of static variables lets several threads, or several
+   targets, disassemble at once.  */
+
 struct riscv_private_data
 {
   bfd_vma gp;
   bfd_vma print_addr;
   bfd_vma hi_addr[OP_MASK_RD + 1];
-};
 
-static const char * const *riscv_gpr_names;
-static const char * const *riscv_fpr_names;
+  /* Options.  If NO_ALIASES, disassemble as the most general insn.  */
+  const char * const *gpr_names;
+  const char * const *fpr_names;
+  int no_aliases;
 
-/* Other options */
-static int no_aliases;	/* If set disassemble as most general inst.  */
+  /* The Xextension and XLEN of the code being disassembled.  EXTENSION
+     is NULL if there is none; XLEN is 0 if it is unknown.  */
+  const char *extension;
+  int xlen;
 
-static void
-set_default_riscv_dis_options (void)
-{
-  riscv_gpr_names = riscv_gpr_names_abi;
-  riscv_fpr_names = riscv_fpr_names_abi;
-  no_aliases = 0;
-}
+  /* A table of struct riscv_dis_bucket, filled in as keys are seen.  */
+  htab_t buckets;
+};
 
 static void
-parse_riscv_dis_option (const char *option)
+parse_riscv_dis_option (struct riscv_private_data *pd, const char *option)
 {
   if (CONST_STRNEQ (option, "no-aliases"))
-    no_aliases = 1;
+    pd->no_aliases = 1;
   else if (CONST_STRNEQ (option, "numeric"))
     {
-      riscv_gpr_names = riscv_gpr_names_numeric;
-      riscv_fpr_names = riscv_fpr_names_numeric;
+      pd->gpr_names = riscv_gpr_names_numeric;
+      pd->fpr_names = riscv_fpr_names_numeric;
     }
-
-  /* Invalid option.  */
-  fprintf (stderr, _("Unrecognized disassembler option: %s\n"), option);
+  else
+    /* Invalid option.  */
+    fprintf (stderr, _("Unrecognized disassembler option: %s\n"), option);
 }
 
 static void
-parse_riscv_dis_options (const char *opts_in)
+parse_riscv_dis_options (struct riscv_private_data *pd, const char *opts_in)
 {
   char *opts = xstrdup (opts_in), *opt = opts, *opt_end = opts;
 
-  set_default_riscv_dis_options ();
-
   for ( ; opt_end != NULL; opt = opt_end + 1)
     {
       if ((opt_end = strchr (opt, ',')) != NULL)
 	*opt_end = 0;
-      parse_riscv_dis_option (opt);
+      parse_riscv_dis_option (pd, opt);
     }
 
   free (opts);
 }
 
+static hashval_t
+riscv_dis_bucket_hash (const void *p)
+{
+  insn_t key = ((const struct riscv_dis_bucket *) p)->key;
+
+  return (hashval_t) (key ^ (key >> 15));
+}
+
+static int
+riscv_dis_bucket_eq (const void *p1, const void *p2)
+{
+  return (((const struct riscv_dis_bucket *) p1)->key
+	  == ((const struct riscv_dis_bucket *) p2)->key);
+}
+
+static void
+riscv_dis_bucket_del (void *p)
+{
+  struct riscv_dis_bucket *bucket = p;
+
+  free (bucket->ops);
+  free (bucket);
+}
+
+/* Return true if OP can be used to disassemble code described by PD.  */
+
+static bfd_boolean
+riscv_dis_opcode_ok_p (const struct riscv_private_data *pd,
+		       const struct riscv_opcode *op)
+{
+  if (op->pinfo == INSN_MACRO)
+    return FALSE;
+  if (pd->no_aliases && (op->pinfo & INSN_ALIAS))
+    return FALSE;
+  if (op->subset[0] == 'X'
+      && (pd->extension == NULL || strcmp (op->subset, pd->extension) != 0))
+    return FALSE;
+  if (pd->xlen == 32 && strncmp (op->subset, "64", 2) == 0)
+    return FALSE;
+  if (pd->xlen == 64 && strncmp (op->subset, "32", 2) == 0)
+    return FALSE;
+  return TRUE;
+}
+
+/* Return the NULL-terminated list of opcodes that might match WORD.
+   The list is built from riscv_opcodes the first time WORD's key bits
+   are seen, and only holds opcodes that agree with all of them.  */
+
+static const struct riscv_opcode **
+riscv_dis_candidates (struct riscv_private_data *pd, insn_t word)
+{
+  struct riscv_dis_bucket tmp, *bucket;
+  const struct riscv_opcode *op;
+  insn_t key_mask;
+  void **slot;
+  int n;
+
+  switch (riscv_insn_length (word))
+    {
+    case 2:
+      key_mask = OP_KEY_MASK_16;
+      break;
+    case 4:
+      key_mask = OP_KEY_MASK_32;
+      break;
+    default:
+      key_mask = OP_MASK_OP;
+      break;
+    }
+
+  tmp.key = word & key_mask;
+  slot = htab_find_slot_with_hash (pd->buckets, &tmp,
+				   riscv_dis_bucket_hash (&tmp), INSERT);
+  if (*slot != NULL)
+    return ((struct riscv_dis_bucket *) *slot)->ops;
+
+  bucket = xmalloc (sizeof (*bucket));
+  bucket->key = tmp.key;
+  bucket->ops = xmalloc ((NUMOPCODES + 1) * sizeof (*bucket->ops));
+  n = 0;
+  for (op = riscv_opcodes; op < &riscv_opcodes[NUMOPCODES]; op++)
+    if (((tmp.key ^ op->match) & op->mask & key_mask) == 0
+	&& riscv_dis_opcode_ok_p (pd, op))
+      bucket->ops[n++] = op;
+  bucket->ops[n++] = NULL;
+  bucket->ops = xrealloc (bucket->ops, n * sizeof (*bucket->ops));
+
+  *slot = bucket;
+  return bucket->ops;
+}
+
+/* Set up INFO->private_data for a new disassemble_info.  */
+
+static struct riscv_private_data *
+riscv_init_private_data (disassemble_info *info)
+{
+  struct riscv_private_data *pd;
+  int i;
+
+  pd = info->private_data = xcalloc (1, sizeof (struct riscv_private_data));
+  pd->gp = -1;
+  pd->print_addr = -1;
+  for (i = 0; i < (int) ARRAY_SIZE(pd->hi_addr); i++)
+    pd->hi_addr[i] = -1;
+
+  for (i = 0; i < info->symtab_size; i++)
+    if (strcmp (bfd_asymbol_name (info->symtab[i]), "_gp") == 0)
+      pd->gp = bfd_asymbol_value (info->symtab[i]);
+
+  pd->gpr_names = riscv_gpr_names_abi;
+  pd->fpr_names = riscv_fpr_names_abi;
+
+  if (info->section != NULL
+      && bfd_get_flavour (info->section->owner) == bfd_target_elf_flavour)
+    {
+      Elf_Internal_Ehdr *ehdr = elf_elfheader (info->section->owner);
+      pd->extension
+	= riscv_elf_flag_to_name (EF_GET_RISCV_EXT (ehdr->e_flags));
+      pd->xlen = ehdr->e_ident[EI_CLASS] == ELFCLASS64 ? 64 : 32;
+    }
+  else if (info->mach == bfd_mach_riscv64)
+    pd->xlen = 64;
+  else if (info->mach == bfd_mach_riscv32)
+    pd->xlen = 32;
+
+  pd->buckets = htab_create_alloc (64, riscv_dis_bucket_hash,
+				   riscv_dis_bucket_eq, riscv_dis_bucket_del,
+				   xcalloc, free);
+  return pd;
+}
+
 /* Print one argument from an array. */
 
 static void
@@ -109,6 +257,101 @@ maybe_print_address (struct riscv_private_data *pd, int base_reg, int offset)
     pd->print_addr = offset;
 }
 
+/* Print the operand of compressed instruction L selected by the
+   character following 'C' in the operand string.  */
+
+static void
+print_insn_rvc_arg (char c, insn_t l, bfd_vma pc, disassemble_info *info)
+{
+  struct riscv_private_data *pd = info->private_data;
+  int rs1s = ((l >> OP_SH_CRS1S) & OP_MASK_CRS1S) + 8;
+  int rs2s = ((l >> OP_SH_CRS2S) & OP_MASK_CRS2S) + 8;
+
+  switch (c)
+    {
+    case 's': /* RS1 x8-x15 */
+    case 'w': /* RS1 x8-x15, also the destination */
+      (*info->fprintf_func) (info->stream, "%s", pd->gpr_names[rs1s]);
+      break;
+    case 't': /* RS2 x8-x15 */
+      (*info->fprintf_func) (info->stream, "%s", pd->gpr_names[rs2s]);
+      break;
+    case 'U': /* RS1, constrained to equal RD */
+      (*info->fprintf_func) (info->stream, "%s",
+			     pd->gpr_names[(l >> OP_SH_RD) & OP_MASK_RD]);
+      break;
+    case 'c': /* RS1, constrained to equal sp */
+      (*info->fprintf_func) (info->stream, "%s", pd->gpr_names[X_SP]);
+      break;
+    case 'V': /* RS2 */
+      (*info->fprintf_func) (info->stream, "%s",
+			     pd->gpr_names[(l >> OP_SH_CRS2) & OP_MASK_CRS2]);
+      break;
+    case 'D': /* floating-point RS2 x8-x15 */
+      (*info->fprintf_func) (info->stream, "%s", pd->fpr_names[rs2s]);
+      break;
+    case 'T': /* floating-point RS2 */
+      (*info->fprintf_func) (info->stream, "%s",
+			     pd->fpr_names[(l >> OP_SH_CRS2) & OP_MASK_CRS2]);
+      break;
+    case 'o':
+    case 'j':
+      (*info->fprintf_func) (info->stream, "%d", (int)EXTRACT_RVC_IMM (l));
+      break;
+    case 'u':
+      (*info->fprintf_func) (info->stream, "0x%x",
+			     (unsigned)(EXTRACT_RVC_IMM (l)
+					& (RISCV_BIGIMM_REACH - 1)));
+      break;
+    case '>':
+      (*info->fprintf_func) (info->stream, "0x%x",
+			     (unsigned)EXTRACT_RVC_IMM (l) & 0x3f);
+      break;
+    case 'k':
+      maybe_print_address (pd, rs1s, EXTRACT_RVC_LW_IMM (l));
+      (*info->fprintf_func) (info->stream, "%d", (int)EXTRACT_RVC_LW_IMM (l));
+      break;
+    case 'l':
+      maybe_print_address (pd, rs1s, EXTRACT_RVC_LD_IMM (l));
+      (*info->fprintf_func) (info->stream, "%d", (int)EXTRACT_RVC_LD_IMM (l));
+      break;
+    case 'm':
+      (*info->fprintf_func) (info->stream, "%d", (int)EXTRACT_RVC_LWSP_IMM (l));
+      break;
+    case 'n':
+      (*info->fprintf_func) (info->stream, "%d", (int)EXTRACT_RVC_LDSP_IMM (l));
+      break;
+    case 'M':
+      (*info->fprintf_func) (info->stream, "%d", (int)EXTRACT_RVC_SWSP_IMM (l));
+      break;
+    case 'N':
+      (*info->fprintf_func) (info->stream, "%d", (int)EXTRACT_RVC_SDSP_IMM (l));
+      break;
+    case 'K':
+      (*info->fprintf_func) (info->stream, "%d",
+			     (int)EXTRACT_RVC_ADDI4SPN_IMM (l));
+      break;
+    case 'L':
+      (*info->fprintf_func) (info->stream, "%d",
+			     (int)EXTRACT_RVC_ADDI16SP_IMM (l));
+      break;
+    case 'p':
+      info->target = EXTRACT_RVC_B_IMM (l) + pc;
+      (*info->print_address_func) (info->target, info);
+      break;
+    case 'a':
+      info->target = EXTRACT_RVC_J_IMM (l) + pc;
+      (*info->print_address_func) (info->target, info);
+      break;
+    default:
+      /* xgettext:c-format */
+      (*info->fprintf_func) (info->stream,
+			     _("# internal error, undefined modifier (C%c)"),
+			     c);
+      break;
+    }
+}
+
 /* Print insn arguments for 32/64-bit code.  */
 
 static void
@@ -212,6 +455,11 @@ print_insn_args (const char *d, insn_t l, bfd_vma pc, disassemble_info *info)
           }
           break;
 
+	/* RVC */
+	case 'C':
+	  print_insn_rvc_arg (*++d, l, pc, info);
+	  break;
+
 	case ',':
 	case '(':
 	case ')':
@@ -225,12 +473,12 @@ print_insn_args (const char *d, insn_t l, bfd_vma pc, disassemble_info *info)
 
 	case 'b':
 	case 's':
-	  (*info->fprintf_func) (info->stream, "%s", riscv_gpr_names[rs1]);
+	  (*info->fprintf_func) (info->stream, "%s", pd->gpr_names[rs1]);
 	  break;
 
 	case 't':
 	  (*info->fprintf_func) (info->stream, "%s",
-				 riscv_gpr_names[(l >> OP_SH_RS2) & OP_MASK_RS2]);
+				 pd->gpr_names[(l >> OP_SH_RS2) & OP_MASK_RS2]);
 	  break;
 
 	case 'u':
@@ -280,11 +528,13 @@ print_insn_args (const char *d, insn_t l, bfd_vma pc, disassemble_info *info)
 	    pd->hi_addr[rd] = pc + EXTRACT_UTYPE_IMM (l);
 	  else if ((l & MASK_LUI) == MATCH_LUI)
 	    pd->hi_addr[rd] = EXTRACT_UTYPE_IMM (l);
-	  (*info->fprintf_func) (info->stream, "%s", riscv_gpr_names[rd]);
+	  else if ((l & MASK_C_LUI) == MATCH_C_LUI)
+	    pd->hi_addr[rd] = EXTRACT_RVC_LUI_IMM (l);
+	  (*info->fprintf_func) (info->stream, "%s", pd->gpr_names[rd]);
 	  break;
 
 	case 'z':
-	  (*info->fprintf_func) (info->stream, "%s", riscv_gpr_names[0]);
+	  (*info->fprintf_func) (info->stream, "%s", pd->gpr_names[0]);
 	  break;
 
 	case '>':
@@ -299,21 +549,21 @@ print_insn_args (const char *d, insn_t l, bfd_vma pc, disassemble_info *info)
 
 	case 'S':
 	case 'U':
-	  (*info->fprintf_func) (info->stream, "%s", riscv_fpr_names[rs1]);
+	  (*info->fprintf_func) (info->stream, "%s", pd->fpr_names[rs1]);
 	  break;
 
 	case 'T':
 	  (*info->fprintf_func) (info->stream, "%s",
-				 riscv_fpr_names[(l >> OP_SH_RS2) & OP_MASK_RS2]);
+				 pd->fpr_names[(l >> OP_SH_RS2) & OP_MASK_RS2]);
 	  break;
 
 	case 'D':
-	  (*info->fprintf_func) (info->stream, "%s", riscv_fpr_names[rd]);
+	  (*info->fprintf_func) (info->stream, "%s", pd->fpr_names[rd]);
 	  break;
 
 	case 'R':
 	  (*info->fprintf_func) (info->stream, "%s",
-				 riscv_fpr_names[(l >> OP_SH_RS3) & OP_MASK_RS3]);
+				 pd->fpr_names[(l >> OP_SH_RS3) & OP_MASK_RS3]);
 	  break;
 
 	case 'E':
@@ -348,55 +598,15 @@ print_insn_args (const char *d, insn_t l, bfd_vma pc, disassemble_info *info)
 }
 
 /* Print the RISC-V instruction at address MEMADDR in debugged memory,
-   on using INFO.  Returns length of the instruction, in bytes.
-   BIGENDIAN must be 1 if this is big-endian code, 0 if
-   this is little-endian code.  */
+   on using INFO.  Returns length of the instruction, in bytes.  */
 
 static int
 riscv_disassemble_insn (bfd_vma memaddr, insn_t word, disassemble_info *info)
 {
-  const struct riscv_opcode *op;
-  static bfd_boolean init = 0;
-  static const char *extension = NULL;
-  static const struct riscv_opcode *riscv_hash[OP_MASK_OP + 1];
-  struct riscv_private_data *pd;
+  struct riscv_private_data *pd = info->private_data;
+  const struct riscv_opcode **ops, *op;
   int insnlen;
 
-  /* Build a hash table to shorten the search time.  */
-  if (! init)
-    {
-      unsigned int i;
-      unsigned int e_flags = elf_elfheader (info->section->owner)->e_flags;
-      extension = riscv_elf_flag_to_name(EF_GET_RISCV_EXT(e_flags));
-
-      for (i = 0; i <= OP_MASK_OP; i++)
-        for (op = riscv_opcodes; op < &riscv_opcodes[NUMOPCODES]; op++)
-          if (i == ((op->match >> OP_SH_OP) & OP_MASK_OP))
-            {
-              riscv_hash[i] = op;
-              break;
-            }
-
-      init = 1;
-    }
-
-  if (info->private_data == NULL)
-    {
-      int i;
-
-      pd = info->private_data = calloc(1, sizeof (struct riscv_private_data));
-      pd->gp = -1;
-      pd->print_addr = -1;
-      for (i = 0; i < (int) ARRAY_SIZE(pd->hi_addr); i++)
-	pd->hi_addr[i] = -1;
-
-      for (i = 0; i < info->symtab_size; i++)
-	if (strcmp (bfd_asymbol_name (info->symtab[i]), "_gp") == 0)
-	  pd->gp = bfd_asymbol_value (info->symtab[i]);
-    }
-  else
-    pd = info->private_data;
-
   insnlen = riscv_insn_length (word);
 
   info->bytes_per_chunk = insnlen % 4 == 0 ? 4 : 2;
@@ -409,28 +619,20 @@ riscv_disassemble_insn (bfd_vma memaddr, insn_t word, disassemble_info *info)
   info->target = 0;
   info->target2 = 0;
 
-  op = riscv_hash[(word >> OP_SH_OP) & OP_MASK_OP];
-  if (op != NULL)
-    {
-      for (; op < &riscv_opcodes[NUMOPCODES]; op++)
-	{
-	  if ((op->match_func) (op, word)
-	      && !(no_aliases && (op->pinfo & INSN_ALIAS))
-	      && !(op->subset[0] == 'X' && strcmp(op->subset, extension)))
-	    {
-	      (*info->fprintf_func) (info->stream, "%s", op->name);
-	      print_insn_args (op->args, word, memaddr, info);
-	      if (pd->print_addr != (bfd_vma)-1)
-		{
-		  info->target = pd->print_addr;
-		  (*info->fprintf_func) (info->stream, " # ");
-		  (*info->print_address_func) (info->target, info);
-		  pd->print_addr = -1;
-		}
-	      return insnlen;
-	    }
-	}
-    }
+  for (ops = riscv_dis_candidates (pd, word); (op = *ops) != NULL; ops++)
+    if ((op->match_func) (op, word))
+      {
+	(*info->fprintf_func) (info->stream, "%s", op->name);
+	print_insn_args (op->args, word, memaddr, info);
+	if (pd->print_addr != (bfd_vma)-1)
+	  {
+	    info->target = pd->print_addr;
+	    (*info->fprintf_func) (info->stream, " # ");
+	    (*info->print_address_func) (info->target, info);
+	    pd->print_addr = -1;
+	  }
+	return insnlen;
+      }
 
   /* Handle undefined instructions.  */
   info->insn_type = dis_noninsn;
@@ -441,19 +643,24 @@ riscv_disassemble_insn (bfd_vma memaddr, insn_t word, disassemble_info *info)
 int
 print_insn_riscv (bfd_vma memaddr, struct disassemble_info *info)
 {
+  struct riscv_private_data *pd;
   uint16_t i2;
   insn_t insn = 0;
   bfd_vma n;
   int status;
 
+  pd = info->private_data;
+  if (pd == NULL)
+    pd = riscv_init_private_data (info);
+
   if (info->disassembler_options != NULL)
     {
-      parse_riscv_dis_options (info->disassembler_options);
+      parse_riscv_dis_options (pd, info->disassembler_options);
       /* Avoid repeatedly parsing the options.  */
       info->disassembler_options = NULL;
+      /* The options decide which opcodes are candidates.  */
+      htab_empty (pd->buckets);
     }
-  else if (riscv_gpr_names == NULL)
-    set_default_riscv_dis_options ();
 
   /* Instructions are a sequence of 2-byte packets in little-endian order.  */
   for (n = 0; n < sizeof(insn) && n < riscv_insn_length (insn); n += 2)
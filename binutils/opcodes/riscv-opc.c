@@ -102,6 +102,10 @@ const char * const riscv_vec_fpr_names[32] =
 #define MASK_AQ (OP_MASK_AQ << OP_SH_AQ)
 #define MASK_RL (OP_MASK_RL << OP_SH_RL)
 #define MASK_AQRL (MASK_AQ | MASK_RL)
+#define MASK_CRS2 (OP_MASK_CRS2 << OP_SH_CRS2)
+#define MASK_RVC_IMM ENCODE_RVC_IMM(-1U)
+#define MASK_RVC_ADDI4SPN_IMM ENCODE_RVC_ADDI4SPN_IMM(-1U)
+#define MASK_RVC_ADDI16SP_IMM ENCODE_RVC_ADDI16SP_IMM(-1U)
 
 static int match_opcode(const struct riscv_opcode *op, insn_t insn)
 {
@@ -120,6 +124,31 @@ static int match_rs1_eq_rs2(const struct riscv_opcode *op, insn_t insn)
     ((insn & MASK_RS1) >> OP_SH_RS1) == ((insn & MASK_RS2) >> OP_SH_RS2);
 }
 
+static int match_rd_nonzero(const struct riscv_opcode *op, insn_t insn)
+{
+  return match_opcode(op, insn) && ((insn & MASK_RD) != 0);
+}
+
+static int match_c_add(const struct riscv_opcode *op, insn_t insn)
+{
+  return match_rd_nonzero(op, insn) && ((insn & MASK_CRS2) != 0);
+}
+
+static int match_c_lui(const struct riscv_opcode *op, insn_t insn)
+{
+  return match_rd_nonzero(op, insn) && (((insn & MASK_RD) >> OP_SH_RD) != 2);
+}
+
+static int match_c_addi4spn(const struct riscv_opcode *op, insn_t insn)
+{
+  return match_opcode(op, insn) && ((insn & MASK_RVC_ADDI4SPN_IMM) != 0);
+}
+
+static int match_c_addi16sp(const struct riscv_opcode *op, insn_t insn)
+{
+  return match_opcode(op, insn) && ((insn & MASK_RVC_ADDI16SP_IMM) != 0);
+}
+
 const struct riscv_opcode riscv_builtin_opcodes[] =
 {
 /* These instructions appear first so that the disassembler will find
@@ -127,14 +156,23 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
    instruction name anyhow.  */
 /* name,      isa,   operands, match, mask, pinfo */
 {"unimp",     "I",   "",         0, 0xffff,  match_opcode, 0 },
+{"nop",       "C",   "",        MATCH_C_ADDI, 0xffff, match_opcode, INSN_ALIAS },
 {"nop",       "I",   "",         MATCH_ADDI, MASK_ADDI | MASK_RD | MASK_RS1 | MASK_IMM, match_opcode,  INSN_ALIAS },
+{"li",        "C",   "d,Co",    MATCH_C_LI, MASK_C_LI, match_rd_nonzero, INSN_ALIAS|WR_xd },
 {"li",        "I",   "d,j",      MATCH_ADDI, MASK_ADDI | MASK_RS1, match_opcode,  INSN_ALIAS|WR_xd }, /* addi */
 {"li",        "I",   "d,I",  0,    (int) M_LI,  match_never, INSN_MACRO },
+{"mv",        "C",   "d,CV",    MATCH_C_MV, MASK_C_MV, match_c_add, INSN_ALIAS|WR_xd|RD_xs2 },
 {"mv",        "I",   "d,s",  MATCH_ADDI, MASK_ADDI | MASK_IMM, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"move",      "C",   "d,CV",    MATCH_C_MV, MASK_C_MV, match_c_add, INSN_ALIAS|WR_xd|RD_xs2 },
 {"move",      "I",   "d,s",  MATCH_ADDI, MASK_ADDI | MASK_IMM, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"andi",      "C",   "Cs,Cw,Co", MATCH_C_ANDI, MASK_C_ANDI, match_opcode, INSN_ALIAS|WR_xd|RD_xs1 },
 {"andi",      "I",   "d,s,j",  MATCH_ANDI, MASK_ANDI, match_opcode,   WR_xd|RD_xs1 },
+{"and",       "C",   "Cs,Cw,Ct", MATCH_C_AND, MASK_C_AND, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
+{"and",       "C",   "Cs,Ct,Cw", MATCH_C_AND, MASK_C_AND, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
+{"and",       "C",   "Cs,Cw,Co", MATCH_C_ANDI, MASK_C_ANDI, match_opcode, INSN_ALIAS|WR_xd|RD_xs1 },
 {"and",       "I",   "d,s,t",  MATCH_AND, MASK_AND, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 {"and",       "I",   "d,s,j",  MATCH_ANDI, MASK_ANDI, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"beqz",      "C",   "Cs,Cp",   MATCH_C_BEQZ, MASK_C_BEQZ, match_opcode, INSN_ALIAS|RD_xs1 },
 {"beqz",      "I",   "s,p",  MATCH_BEQ, MASK_BEQ | MASK_RS2, match_opcode,   INSN_ALIAS|RD_xs1 },
 {"beq",       "I",   "s,t,p",  MATCH_BEQ, MASK_BEQ, match_opcode,   RD_xs1|RD_xs2 },
 {"blez",      "I",   "t,p",  MATCH_BGE, MASK_BGE | MASK_RS1, match_opcode,   INSN_ALIAS|RD_xs2 },
@@ -149,9 +187,18 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
 {"bltu",      "I",   "s,t,p",  MATCH_BLTU, MASK_BLTU, match_opcode,   RD_xs1|RD_xs2 },
 {"bgt",       "I",   "t,s,p",  MATCH_BLT, MASK_BLT, match_opcode,   INSN_ALIAS|RD_xs1|RD_xs2 },
 {"bgtu",      "I",   "t,s,p",  MATCH_BLTU, MASK_BLTU, match_opcode,   INSN_ALIAS|RD_xs1|RD_xs2 },
+{"bnez",      "C",   "Cs,Cp",   MATCH_C_BNEZ, MASK_C_BNEZ, match_opcode, INSN_ALIAS|RD_xs1 },
 {"bnez",      "I",   "s,p",  MATCH_BNE, MASK_BNE | MASK_RS2, match_opcode,   INSN_ALIAS|RD_xs1 },
 {"bne",       "I",   "s,t,p",  MATCH_BNE, MASK_BNE, match_opcode,   RD_xs1|RD_xs2 },
+{"addi",      "C",   "Ct,Cc,CK", MATCH_C_ADDI4SPN, MASK_C_ADDI4SPN, match_c_addi4spn, INSN_ALIAS|WR_xd|RD_xs1 },
+{"addi",      "C",   "d,CU,Cj", MATCH_C_ADDI, MASK_C_ADDI, match_rd_nonzero, INSN_ALIAS|WR_xd|RD_xs1 },
+{"addi",      "C",   "Cc,Cc,CL", MATCH_C_ADDI16SP, MASK_C_ADDI16SP, match_c_addi16sp, INSN_ALIAS|WR_xd|RD_xs1 },
 {"addi",      "I",   "d,s,j",  MATCH_ADDI, MASK_ADDI, match_opcode,  WR_xd|RD_xs1 },
+{"add",       "C",   "d,CU,CV", MATCH_C_ADD, MASK_C_ADD, match_c_add, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
+{"add",       "C",   "d,CV,CU", MATCH_C_ADD, MASK_C_ADD, match_c_add, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
+{"add",       "C",   "d,CU,Cj", MATCH_C_ADDI, MASK_C_ADDI, match_rd_nonzero, INSN_ALIAS|WR_xd|RD_xs1 },
+{"add",       "C",   "Ct,Cc,CK", MATCH_C_ADDI4SPN, MASK_C_ADDI4SPN, match_c_addi4spn, INSN_ALIAS|WR_xd|RD_xs1 },
+{"add",       "C",   "Cc,Cc,CL", MATCH_C_ADDI16SP, MASK_C_ADDI16SP, match_c_addi16sp, INSN_ALIAS|WR_xd|RD_xs1 },
 {"add",       "I",   "d,s,t",  MATCH_ADD, MASK_ADD, match_opcode,  WR_xd|RD_xs1|RD_xs2 },
 {"add",       "I",   "d,s,t,0",MATCH_ADD, MASK_ADD, match_opcode,  WR_xd|RD_xs1|RD_xs2 },
 {"add",       "I",   "d,s,j",  MATCH_ADDI, MASK_ADDI, match_opcode,  INSN_ALIAS|WR_xd|RD_xs1 },
@@ -160,25 +207,38 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
 {"la.tls.gd", "I",   "d,A",  0,    (int) M_LA_TLS_GD,  match_never, INSN_MACRO },
 {"la.tls.ie", "I",   "d,A",  0,    (int) M_LA_TLS_IE,  match_never, INSN_MACRO },
 {"neg",       "I",   "d,t",  MATCH_SUB, MASK_SUB | MASK_RS1, match_opcode,   INSN_ALIAS|WR_xd|RD_xs2 }, /* sub 0 */
+{"slli",      "C",   "d,CU,C>", MATCH_C_SLLI, MASK_C_SLLI, match_rd_nonzero, INSN_ALIAS|WR_xd|RD_xs1 },
 {"slli",      "I",   "d,s,>",   MATCH_SLLI, MASK_SLLI, match_opcode,   WR_xd|RD_xs1 },
+{"sll",       "C",   "d,CU,C>", MATCH_C_SLLI, MASK_C_SLLI, match_rd_nonzero, INSN_ALIAS|WR_xd|RD_xs1 },
 {"sll",       "I",   "d,s,t",   MATCH_SLL, MASK_SLL, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 {"sll",       "I",   "d,s,>",   MATCH_SLLI, MASK_SLLI, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"srli",      "C",   "Cs,Cw,C>", MATCH_C_SRLI, MASK_C_SRLI, match_opcode, INSN_ALIAS|WR_xd|RD_xs1 },
 {"srli",      "I",   "d,s,>",   MATCH_SRLI, MASK_SRLI, match_opcode,   WR_xd|RD_xs1 },
+{"srl",       "C",   "Cs,Cw,C>", MATCH_C_SRLI, MASK_C_SRLI, match_opcode, INSN_ALIAS|WR_xd|RD_xs1 },
 {"srl",       "I",   "d,s,t",   MATCH_SRL, MASK_SRL, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 {"srl",       "I",   "d,s,>",   MATCH_SRLI, MASK_SRLI, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"srai",      "C",   "Cs,Cw,C>", MATCH_C_SRAI, MASK_C_SRAI, match_opcode, INSN_ALIAS|WR_xd|RD_xs1 },
 {"srai",      "I",   "d,s,>",   MATCH_SRAI, MASK_SRAI, match_opcode,   WR_xd|RD_xs1 },
+{"sra",       "C",   "Cs,Cw,C>", MATCH_C_SRAI, MASK_C_SRAI, match_opcode, INSN_ALIAS|WR_xd|RD_xs1 },
 {"sra",       "I",   "d,s,t",   MATCH_SRA, MASK_SRA, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 {"sra",       "I",   "d,s,>",   MATCH_SRAI, MASK_SRAI, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"sub",       "C",   "Cs,Cw,Ct", MATCH_C_SUB, MASK_C_SUB, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
 {"sub",       "I",   "d,s,t",  MATCH_SUB, MASK_SUB, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
+{"ret",       "C",   "",        MATCH_C_JR | (X_RA << OP_SH_RD), MASK_C_JR | MASK_RD, match_opcode, INSN_ALIAS },
 {"ret",       "I",   "",  MATCH_JALR | (X_RA << OP_SH_RS1), MASK_JALR | MASK_RD | MASK_RS1 | MASK_IMM, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"j",         "C",   "Ca",      MATCH_C_J, MASK_C_J, match_opcode, INSN_ALIAS },
 {"j",         "I",   "a",  MATCH_JAL, MASK_JAL | MASK_RD, match_opcode,   INSN_ALIAS },
+{"jal",       "32C", "Ca",      MATCH_C_JAL, MASK_C_JAL, match_opcode, INSN_ALIAS|WR_xd },
 {"jal",       "I",   "a",  MATCH_JAL | (X_RA << OP_SH_RD), MASK_JAL | MASK_RD, match_opcode,   INSN_ALIAS|WR_xd },
 {"jal",       "I",   "d,a",  MATCH_JAL, MASK_JAL, match_opcode,   WR_xd },
 {"call",      "I",   "c", (X_T0 << OP_SH_RS1) | (X_RA << OP_SH_RD), (int) M_CALL,  match_never, INSN_MACRO },
+{"call",      "I",   "d,c", (X_T0 << OP_SH_RS1), (int) M_CALL,  match_never, INSN_MACRO },
 {"tail",      "I",   "c", (X_T0 << OP_SH_RS1), (int) M_CALL,  match_never, INSN_MACRO },
 {"jump",      "I",   "c,s", 0, (int) M_CALL,  match_never, INSN_MACRO },
+{"jr",        "C",   "d",       MATCH_C_JR, MASK_C_JR, match_rd_nonzero, INSN_ALIAS|RD_xs1 },
 {"jr",        "I",   "s",  MATCH_JALR, MASK_JALR | MASK_RD | MASK_IMM, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
 {"jr",        "I",   "s,j",  MATCH_JALR, MASK_JALR | MASK_RD, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"jalr",      "C",   "d",       MATCH_C_JALR, MASK_C_JALR, match_rd_nonzero, INSN_ALIAS|WR_xd|RD_xs1 },
 {"jalr",      "I",   "s",  MATCH_JALR | (X_RA << OP_SH_RD), MASK_JALR | MASK_RD | MASK_IMM, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
 {"jalr",      "I",   "s,j",  MATCH_JALR | (X_RA << OP_SH_RD), MASK_JALR | MASK_RD, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
 {"jalr",      "I",   "d,s",  MATCH_JALR, MASK_JALR | MASK_IMM, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
@@ -191,12 +251,17 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
 {"lh",        "I",   "d,A",  0, (int) M_LH, match_never, INSN_MACRO },
 {"lhu",       "I",   "d,o(s)",  MATCH_LHU, MASK_LHU, match_opcode,   WR_xd|RD_xs1 },
 {"lhu",       "I",   "d,A",  0, (int) M_LHU, match_never, INSN_MACRO },
+{"lw",        "C",   "d,Cm(Cc)", MATCH_C_LWSP, MASK_C_LWSP, match_rd_nonzero, INSN_ALIAS|WR_xd },
+{"lw",        "C",   "Ct,Ck(Cs)", MATCH_C_LW, MASK_C_LW, match_opcode, INSN_ALIAS|WR_xd|RD_xs1 },
 {"lw",        "I",   "d,o(s)",  MATCH_LW, MASK_LW, match_opcode,   WR_xd|RD_xs1 },
 {"lw",        "I",   "d,A",  0, (int) M_LW, match_never, INSN_MACRO },
 {"ltag",      "I",   "d,o(s)", MATCH_LTAG, MASK_LTAG, match_opcode, WR_xd|RD_xs1 },
+{"lui",       "C",   "d,Cu",    MATCH_C_LUI, MASK_C_LUI, match_c_lui, INSN_ALIAS|WR_xd },
 {"lui",       "I",   "d,u",  MATCH_LUI, MASK_LUI, match_opcode,   WR_xd },
 {"not",       "I",   "d,s",  MATCH_XORI | MASK_IMM, MASK_XORI | MASK_IMM, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
 {"ori",       "I",   "d,s,j",  MATCH_ORI, MASK_ORI, match_opcode,   WR_xd|RD_xs1 },
+{"or",        "C",   "Cs,Cw,Ct", MATCH_C_OR, MASK_C_OR, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
+{"or",        "C",   "Cs,Ct,Cw", MATCH_C_OR, MASK_C_OR, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
 {"or",        "I",   "d,s,t",  MATCH_OR, MASK_OR, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 {"or",        "I",   "d,s,j",  MATCH_ORI, MASK_ORI, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
 {"auipc",     "I",   "d,u",  MATCH_AUIPC, MASK_AUIPC, match_opcode,  WR_xd },
@@ -216,6 +281,8 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
 {"sb",        "I",   "t,A,s",  0, (int) M_SB, match_never,  INSN_MACRO },
 {"sh",        "I",   "t,q(s)",  MATCH_SH, MASK_SH, match_opcode,   RD_xs1|RD_xs2 },
 {"sh",        "I",   "t,A,s",  0, (int) M_SH, match_never,  INSN_MACRO },
+{"sw",        "C",   "CV,CM(Cc)", MATCH_C_SWSP, MASK_C_SWSP, match_opcode, INSN_ALIAS|RD_xs1|RD_xs2 },
+{"sw",        "C",   "Ct,Ck(Cs)", MATCH_C_SW, MASK_C_SW, match_opcode, INSN_ALIAS|RD_xs1|RD_xs2 },
 {"sw",        "I",   "t,q(s)",  MATCH_SW, MASK_SW, match_opcode,   RD_xs1|RD_xs2 },
 {"sw",        "I",   "t,A,s",  0, (int) M_SW, match_never,  INSN_MACRO },
 {"stag",      "I",   "t,q(s)",  MATCH_STAG, MASK_STAG, match_opcode,   RD_xs1|RD_xs2 },
@@ -228,19 +295,31 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
 {"rdcycleh",  "32I", "d",  MATCH_RDCYCLEH, MASK_RDCYCLEH, match_opcode,  WR_xd },
 {"rdinstreth","32I", "d",  MATCH_RDINSTRETH, MASK_RDINSTRETH, match_opcode,  WR_xd },
 {"rdtimeh",   "32I", "d",  MATCH_RDTIMEH, MASK_RDTIMEH, match_opcode,  WR_xd },
+{"sbreak",    "C",   "",        MATCH_C_EBREAK, MASK_C_EBREAK, match_opcode, INSN_ALIAS },
 {"sbreak",    "I",   "",    MATCH_SBREAK, MASK_SBREAK, match_opcode,   0 },
 {"scall",     "I",   "",    MATCH_SCALL, MASK_SCALL, match_opcode,   0 },
 {"xori",      "I",   "d,s,j",  MATCH_XORI, MASK_XORI, match_opcode,   WR_xd|RD_xs1 },
+{"xor",       "C",   "Cs,Cw,Ct", MATCH_C_XOR, MASK_C_XOR, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
+{"xor",       "C",   "Cs,Ct,Cw", MATCH_C_XOR, MASK_C_XOR, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
 {"xor",       "I",   "d,s,t",  MATCH_XOR, MASK_XOR, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 {"xor",       "I",   "d,s,j",  MATCH_XORI, MASK_XORI, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
 {"lwu",       "64I", "d,o(s)",  MATCH_LWU, MASK_LWU, match_opcode,   WR_xd|RD_xs1 },
 {"lwu",       "64I", "d,A",  0, (int) M_LWU, match_never, INSN_MACRO },
+{"ld",        "64C", "d,Cn(Cc)", MATCH_C_LDSP, MASK_C_LDSP, match_rd_nonzero, INSN_ALIAS|WR_xd },
+{"ld",        "64C", "Ct,Cl(Cs)", MATCH_C_LD, MASK_C_LD, match_opcode, INSN_ALIAS|WR_xd|RD_xs1 },
 {"ld",        "64I", "d,o(s)", MATCH_LD, MASK_LD, match_opcode,  WR_xd|RD_xs1 },
 {"ld",        "64I", "d,A",  0, (int) M_LD, match_never, INSN_MACRO },
+{"sd",        "64C", "CV,CN(Cc)", MATCH_C_SDSP, MASK_C_SDSP, match_opcode, INSN_ALIAS|RD_xs1|RD_xs2 },
+{"sd",        "64C", "Ct,Cl(Cs)", MATCH_C_SD, MASK_C_SD, match_opcode, INSN_ALIAS|RD_xs1|RD_xs2 },
 {"sd",        "64I", "t,q(s)",  MATCH_SD, MASK_SD, match_opcode,   RD_xs1|RD_xs2 },
 {"sd",        "64I", "t,A,s",  0, (int) M_SD, match_never,  INSN_MACRO },
+{"sext.w",    "64C", "d,CU",    MATCH_C_ADDIW, MASK_C_ADDIW | MASK_RVC_IMM, match_rd_nonzero, INSN_ALIAS|WR_xd|RD_xs1 },
 {"sext.w",    "64I", "d,s",  MATCH_ADDIW, MASK_ADDIW | MASK_IMM, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"addiw",     "64C", "d,CU,Co", MATCH_C_ADDIW, MASK_C_ADDIW, match_rd_nonzero, INSN_ALIAS|WR_xd|RD_xs1 },
 {"addiw",     "64I", "d,s,j",  MATCH_ADDIW, MASK_ADDIW, match_opcode,   WR_xd|RD_xs1 },
+{"addw",      "64C", "Cs,Cw,Ct", MATCH_C_ADDW, MASK_C_ADDW, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
+{"addw",      "64C", "Cs,Ct,Cw", MATCH_C_ADDW, MASK_C_ADDW, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
+{"addw",      "64C", "d,CU,Co", MATCH_C_ADDIW, MASK_C_ADDIW, match_rd_nonzero, INSN_ALIAS|WR_xd|RD_xs1 },
 {"addw",      "64I", "d,s,t",  MATCH_ADDW, MASK_ADDW, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 {"addw",      "64I", "d,s,j",  MATCH_ADDIW, MASK_ADDIW, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
 {"negw",      "64I", "d,t",  MATCH_SUBW, MASK_SUBW | MASK_RS1, match_opcode,   INSN_ALIAS|WR_xd|RD_xs2 }, /* sub 0 */
@@ -253,8 +332,53 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
 {"sraiw",     "64I", "d,s,<",   MATCH_SRAIW, MASK_SRAIW, match_opcode,   WR_xd|RD_xs1 },
 {"sraw",      "64I", "d,s,t",   MATCH_SRAW, MASK_SRAW, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 {"sraw",      "64I", "d,s,<",   MATCH_SRAIW, MASK_SRAIW, match_opcode,   INSN_ALIAS|WR_xd|RD_xs1 },
+{"subw",      "64C", "Cs,Cw,Ct", MATCH_C_SUBW, MASK_C_SUBW, match_opcode, INSN_ALIAS|WR_xd|RD_xs1|RD_xs2 },
 {"subw",      "64I", "d,s,t",  MATCH_SUBW, MASK_SUBW, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
 
+/* Compressed instruction subset */
+{"c.ebreak",  "C",   "",        MATCH_C_EBREAK, MASK_C_EBREAK, match_opcode, 0 },
+{"c.jr",      "C",   "d",       MATCH_C_JR, MASK_C_JR, match_rd_nonzero, RD_xs1 },
+{"c.jalr",    "C",   "d",       MATCH_C_JALR, MASK_C_JALR, match_rd_nonzero, WR_xd|RD_xs1 },
+{"c.j",       "C",   "Ca",      MATCH_C_J, MASK_C_J, match_opcode, 0 },
+{"c.jal",     "32C", "Ca",      MATCH_C_JAL, MASK_C_JAL, match_opcode, WR_xd },
+{"c.beqz",    "C",   "Cs,Cp",   MATCH_C_BEQZ, MASK_C_BEQZ, match_opcode, RD_xs1 },
+{"c.bnez",    "C",   "Cs,Cp",   MATCH_C_BNEZ, MASK_C_BNEZ, match_opcode, RD_xs1 },
+{"c.lwsp",    "C",   "d,Cm(Cc)", MATCH_C_LWSP, MASK_C_LWSP, match_rd_nonzero, WR_xd },
+{"c.lw",      "C",   "Ct,Ck(Cs)", MATCH_C_LW, MASK_C_LW, match_opcode, WR_xd|RD_xs1 },
+{"c.swsp",    "C",   "CV,CM(Cc)", MATCH_C_SWSP, MASK_C_SWSP, match_opcode, RD_xs1|RD_xs2 },
+{"c.sw",      "C",   "Ct,Ck(Cs)", MATCH_C_SW, MASK_C_SW, match_opcode, RD_xs1|RD_xs2 },
+{"c.nop",     "C",   "",        MATCH_C_ADDI, 0xffff, match_opcode, 0 },
+{"c.mv",      "C",   "d,CV",    MATCH_C_MV, MASK_C_MV, match_c_add, WR_xd|RD_xs2 },
+{"c.lui",     "C",   "d,Cu",    MATCH_C_LUI, MASK_C_LUI, match_c_lui, WR_xd },
+{"c.li",      "C",   "d,Co",    MATCH_C_LI, MASK_C_LI, match_rd_nonzero, WR_xd },
+{"c.addi4spn", "C",   "Ct,Cc,CK", MATCH_C_ADDI4SPN, MASK_C_ADDI4SPN, match_c_addi4spn, WR_xd|RD_xs1 },
+{"c.addi16sp", "C",   "Cc,CL",   MATCH_C_ADDI16SP, MASK_C_ADDI16SP, match_c_addi16sp, WR_xd|RD_xs1 },
+{"c.addi",    "C",   "d,Cj",    MATCH_C_ADDI, MASK_C_ADDI, match_rd_nonzero, WR_xd|RD_xs1 },
+{"c.add",     "C",   "d,CV",    MATCH_C_ADD, MASK_C_ADD, match_c_add, WR_xd|RD_xs1|RD_xs2 },
+{"c.sub",     "C",   "Cs,Ct",   MATCH_C_SUB, MASK_C_SUB, match_opcode, WR_xd|RD_xs1|RD_xs2 },
+{"c.and",     "C",   "Cs,Ct",   MATCH_C_AND, MASK_C_AND, match_opcode, WR_xd|RD_xs1|RD_xs2 },
+{"c.or",      "C",   "Cs,Ct",   MATCH_C_OR, MASK_C_OR, match_opcode, WR_xd|RD_xs1|RD_xs2 },
+{"c.xor",     "C",   "Cs,Ct",   MATCH_C_XOR, MASK_C_XOR, match_opcode, WR_xd|RD_xs1|RD_xs2 },
+{"c.slli",    "C",   "d,C>",    MATCH_C_SLLI, MASK_C_SLLI, match_rd_nonzero, WR_xd|RD_xs1 },
+{"c.srli",    "C",   "Cs,C>",   MATCH_C_SRLI, MASK_C_SRLI, match_opcode, WR_xd|RD_xs1 },
+{"c.srai",    "C",   "Cs,C>",   MATCH_C_SRAI, MASK_C_SRAI, match_opcode, WR_xd|RD_xs1 },
+{"c.andi",    "C",   "Cs,Co",   MATCH_C_ANDI, MASK_C_ANDI, match_opcode, WR_xd|RD_xs1 },
+{"c.addiw",   "64C", "d,Co",    MATCH_C_ADDIW, MASK_C_ADDIW, match_rd_nonzero, WR_xd|RD_xs1 },
+{"c.addw",    "64C", "Cs,Ct",   MATCH_C_ADDW, MASK_C_ADDW, match_opcode, WR_xd|RD_xs1|RD_xs2 },
+{"c.subw",    "64C", "Cs,Ct",   MATCH_C_SUBW, MASK_C_SUBW, match_opcode, WR_xd|RD_xs1|RD_xs2 },
+{"c.ldsp",    "64C", "d,Cn(Cc)", MATCH_C_LDSP, MASK_C_LDSP, match_rd_nonzero, WR_xd },
+{"c.ld",      "64C", "Ct,Cl(Cs)", MATCH_C_LD, MASK_C_LD, match_opcode, WR_xd|RD_xs1 },
+{"c.sdsp",    "64C", "CV,CN(Cc)", MATCH_C_SDSP, MASK_C_SDSP, match_opcode, RD_xs1|RD_xs2 },
+{"c.sd",      "64C", "Ct,Cl(Cs)", MATCH_C_SD, MASK_C_SD, match_opcode, RD_xs1|RD_xs2 },
+{"c.fldsp",   "DC",  "D,Cn(Cc)", MATCH_C_FLDSP, MASK_C_FLDSP, match_opcode, WR_fd },
+{"c.fld",     "DC",  "CD,Cl(Cs)", MATCH_C_FLD, MASK_C_FLD, match_opcode, WR_fd|RD_xs1 },
+{"c.fsdsp",   "DC",  "CT,CN(Cc)", MATCH_C_FSDSP, MASK_C_FSDSP, match_opcode, RD_xs1|RD_fs2 },
+{"c.fsd",     "DC",  "CD,Cl(Cs)", MATCH_C_FSD, MASK_C_FSD, match_opcode, RD_xs1|RD_fs2 },
+{"c.flwsp",   "32FC","D,Cm(Cc)", MATCH_C_FLWSP, MASK_C_FLWSP, match_opcode, WR_fd },
+{"c.flw",     "32FC","CD,Ck(Cs)", MATCH_C_FLW, MASK_C_FLW, match_opcode, WR_fd|RD_xs1 },
+{"c.fswsp",   "32FC","CT,CM(Cc)", MATCH_C_FSWSP, MASK_C_FSWSP, match_opcode, RD_xs1|RD_fs2 },
+{"c.fsw",     "32FC","CD,Ck(Cs)", MATCH_C_FSW, MASK_C_FSW, match_opcode, RD_xs1|RD_fs2 },
+
 /* Atomic memory operation instruction subset */
 {"lr.w",         "A",   "d,0(s)",    MATCH_LR_W, MASK_LR_W | MASK_AQRL, match_opcode,   WR_xd|RD_xs1 },
 {"sc.w",         "A",   "d,t,0(s)",  MATCH_SC_W, MASK_SC_W | MASK_AQRL, match_opcode,   WR_xd|RD_xs1|RD_xs2 },
@@ -373,8 +497,12 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
 {"frflags",   "F",   "d",  MATCH_FRFLAGS, MASK_FRFLAGS, match_opcode,  WR_xd },
 {"fsflags",   "F",   "s",  MATCH_FSFLAGS, MASK_FSFLAGS | MASK_RD, match_opcode,  RD_xs1 },
 {"fsflags",   "F",   "d,s",  MATCH_FSFLAGS, MASK_FSFLAGS, match_opcode,  WR_xd|RD_xs1 },
+{"flw",       "32FC","D,Cm(Cc)", MATCH_C_FLWSP, MASK_C_FLWSP, match_opcode, INSN_ALIAS|WR_fd },
+{"flw",       "32FC","CD,Ck(Cs)", MATCH_C_FLW, MASK_C_FLW, match_opcode, INSN_ALIAS|WR_fd|RD_xs1 },
 {"flw",       "F",   "D,o(s)",  MATCH_FLW, MASK_FLW, match_opcode,   WR_fd|RD_xs1 },
 {"flw",       "F",   "D,A,s",  0, (int) M_FLW, match_never,  INSN_MACRO },
+{"fsw",       "32FC","CT,CM(Cc)", MATCH_C_FSWSP, MASK_C_FSWSP, match_opcode, INSN_ALIAS|RD_xs1|RD_fs2 },
+{"fsw",       "32FC","CD,Ck(Cs)", MATCH_C_FSW, MASK_C_FSW, match_opcode, INSN_ALIAS|RD_xs1|RD_fs2 },
 {"fsw",       "F",   "T,q(s)",  MATCH_FSW, MASK_FSW, match_opcode,   RD_xs1|RD_fs2 },
 {"fsw",       "F",   "T,A,s",  0, (int) M_FSW, match_never,  INSN_MACRO },
 {"fmv.x.s",   "F",   "d,S",  MATCH_FMV_X_S, MASK_FMV_X_S, match_opcode,  WR_xd|RD_fs1 },
@@ -429,8 +557,12 @@ const struct riscv_opcode riscv_builtin_opcodes[] =
 {"fcvt.s.lu", "64F", "D,s,m",  MATCH_FCVT_S_LU, MASK_FCVT_S_LU, match_opcode,   WR_fd|RD_xs1 },
 
 /* Double-precision floating-point instruction subset */
+{"fld",       "DC",  "D,Cn(Cc)", MATCH_C_FLDSP, MASK_C_FLDSP, match_opcode, INSN_ALIAS|WR_fd },
+{"fld",       "DC",  "CD,Cl(Cs)", MATCH_C_FLD, MASK_C_FLD, match_opcode, INSN_ALIAS|WR_fd|RD_xs1 },
 {"fld",       "D",   "D,o(s)",  MATCH_FLD, MASK_FLD, match_opcode,  WR_fd|RD_xs1 },
 {"fld",       "D",   "D,A,s",  0, (int) M_FLD, match_never,  INSN_MACRO },
+{"fsd",       "DC",  "CT,CN(Cc)", MATCH_C_FSDSP, MASK_C_FSDSP, match_opcode, INSN_ALIAS|RD_xs1|RD_fs2 },
+{"fsd",       "DC",  "CD,Cl(Cs)", MATCH_C_FSD, MASK_C_FSD, match_opcode, INSN_ALIAS|RD_xs1|RD_fs2 },
 {"fsd",       "D",   "T,q(s)",  MATCH_FSD, MASK_FSD, match_opcode,  RD_xs1|RD_fs2 },
 {"fsd",       "D",   "T,A,s",  0, (int) M_FSD, match_never,  INSN_MACRO },
 {"fmv.d",     "D",   "D,U",  MATCH_FSGNJ_D, MASK_FSGNJ_D, match_rs1_eq_rs2,   INSN_ALIAS|WR_fd|RD_fs1|RD_fs2 },
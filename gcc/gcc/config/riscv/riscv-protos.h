@@ -53,11 +53,15 @@ extern const char *mips_riscv_output_vector_move (enum machine_mode, rtx, rtx);
 #ifdef RTX_CODE
 extern void riscv_expand_scc (rtx *);
 extern void riscv_expand_conditional_branch (rtx *);
+extern bool riscv_expand_conditional_move (rtx *);
 #endif
 extern rtx riscv_expand_call (bool, rtx, rtx, rtx);
 extern void riscv_expand_fcc_reload (rtx, rtx, rtx);
 extern void riscv_set_return_address (rtx, rtx);
 extern bool riscv_expand_block_move (rtx, rtx, rtx);
+extern bool riscv_expand_block_set (rtx, rtx, rtx);
+extern bool riscv_expand_block_compare (rtx, rtx, rtx, rtx, rtx);
+extern bool riscv_expand_strlen (rtx, rtx, rtx, rtx);
 extern void riscv_expand_synci_loop (rtx, rtx);
 
 extern bool riscv_expand_ext_as_unaligned_load (rtx, rtx, HOST_WIDE_INT,
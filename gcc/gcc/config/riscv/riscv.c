@@ -55,6 +55,7 @@ along with GCC; see the file COPYING3.  If not see
 #include "target-globals.h"
 #include "symcat.h"
 #include <stdint.h>
+#include "config/riscv/riscv-const.h"
 
 /* True if X is an UNSPEC wrapper around a SYMBOL_REF or LABEL_REF.  */
 #define UNSPEC_ADDRESS_P(X)					\
@@ -157,6 +158,10 @@ struct GTY(())  riscv_frame_info {
 
   /* The offset of arg_pointer_rtx from the bottom of the frame.  */
   HOST_WIDE_INT arg_pointer_offset;
+
+  /* The size of the GPR save area if it is allocated and filled by
+     the -msave-restore routines, otherwise 0.  */
+  HOST_WIDE_INT save_libcall_adjustment;
 };
 
 struct GTY(())  machine_function {
@@ -231,9 +236,8 @@ struct mips_integer_op {
 };
 
 /* The largest number of operations needed to load an integer constant.
-   The worst case is LUI, ADDI, SLLI, ADDI, SLLI, ADDI, SLLI, ADDI,
-   but we may attempt and reject even worse sequences.  */
-#define RISCV_MAX_INTEGER_OPS 32
+   The worst case is LUI, ADDI, SLLI, ADDI, SLLI, ADDI, SLLI, ADDI.  */
+#define RISCV_MAX_INTEGER_OPS RISCV_CONST_MAX_OPS
 
 /* Costs of various operations on the different architectures.  */
 
@@ -248,6 +252,10 @@ struct riscv_tune_info
   unsigned short branch_cost;
   unsigned short fp_to_int_cost;
   unsigned short memory_cost;
+  unsigned short set_words;
+  unsigned short cmp_words;
+  unsigned short strlen_unroll;
+  unsigned short select_insns;
 };
 
 /* Information about one CPU we know about.  */
@@ -258,6 +266,9 @@ struct riscv_cpu_info {
   /* The RISC-V ISA and extensions supported by this CPU.  */
   const char *isa;
 
+  /* The pipeline model the scheduler should use for this CPU.  */
+  enum riscv_microarchitecture_type microarchitecture;
+
   /* Tuning parameters for this CPU.  */
   const struct riscv_tune_info *tune_info;
 };
@@ -267,6 +278,9 @@ struct riscv_cpu_info {
 /* Which tuning parameters to use.  */
 static const struct riscv_tune_info *tune_info;
 
+/* Which pipeline description to use; see the "tune" attribute.  */
+enum riscv_microarchitecture_type riscv_microarchitecture;
+
 /* Index [M][R] is true if register R is allowed to hold a value of mode M.  */
 bool riscv_hard_regno_mode_ok[(int) MAX_MACHINE_MODE][FIRST_PSEUDO_REGISTER];
 
@@ -299,7 +313,24 @@ const enum reg_class riscv_regno_to_class[FIRST_PSEUDO_REGISTER] = {
   FRAME_REGS,	FRAME_REGS,
 };
 
-/* Costs to use when optimizing for size.  */
+/* Costs to use for processors without a specific pipeline model.  */
+static const struct riscv_tune_info generic_tune_info = {
+  {COSTS_N_INSNS (4), COSTS_N_INSNS (5)},	/* fp_add */
+  {COSTS_N_INSNS (4), COSTS_N_INSNS (5)},	/* fp_mul */
+  {COSTS_N_INSNS (20), COSTS_N_INSNS (20)},	/* fp_div */
+  {COSTS_N_INSNS (4), COSTS_N_INSNS (4)},	/* int_mul */
+  {COSTS_N_INSNS (6), COSTS_N_INSNS (6)},	/* int_div */
+  1,						/* issue_rate */
+  3,						/* branch_cost */
+  COSTS_N_INSNS (2),				/* fp_to_int_cost */
+  5,						/* memory_cost */
+  8,						/* set_words */
+  4,						/* cmp_words */
+  2,						/* strlen_unroll */
+  5						/* select_insns */
+};
+
+/* Costs to use for the single-issue, in-order Rocket core.  */
 static const struct riscv_tune_info rocket_tune_info = {
   {COSTS_N_INSNS (4), COSTS_N_INSNS (5)},	/* fp_add */
   {COSTS_N_INSNS (4), COSTS_N_INSNS (5)},	/* fp_mul */
@@ -309,7 +340,28 @@ static const struct riscv_tune_info rocket_tune_info = {
   1,						/* issue_rate */
   3,						/* branch_cost */
   COSTS_N_INSNS (2),				/* fp_to_int_cost */
-  5						/* memory_cost */
+  5,						/* memory_cost */
+  8,						/* set_words */
+  4,						/* cmp_words */
+  2,						/* strlen_unroll */
+  5						/* select_insns */
+};
+
+/* Costs to use for dual-issue, in-order SiFive 7-series cores.  */
+static const struct riscv_tune_info sifive_7_tune_info = {
+  {COSTS_N_INSNS (5), COSTS_N_INSNS (5)},	/* fp_add */
+  {COSTS_N_INSNS (5), COSTS_N_INSNS (7)},	/* fp_mul */
+  {COSTS_N_INSNS (27), COSTS_N_INSNS (56)},	/* fp_div */
+  {COSTS_N_INSNS (3), COSTS_N_INSNS (3)},	/* int_mul */
+  {COSTS_N_INSNS (33), COSTS_N_INSNS (65)},	/* int_div */
+  2,						/* issue_rate */
+  4,						/* branch_cost */
+  COSTS_N_INSNS (2),				/* fp_to_int_cost */
+  3,						/* memory_cost */
+  16,						/* set_words */
+  4,						/* cmp_words */
+  4,						/* strlen_unroll */
+  6						/* select_insns */
 };
 
 /* Costs to use when optimizing for size.  */
@@ -322,13 +374,21 @@ static const struct riscv_tune_info optimize_size_tune_info = {
   1,						/* issue_rate */
   1,						/* branch_cost */
   COSTS_N_INSNS (1),				/* fp_to_int_cost */
-  1						/* memory_cost */
+  1,						/* memory_cost */
+  2,						/* set_words */
+  0,						/* cmp_words */
+  0,						/* strlen_unroll */
+  0						/* select_insns */
 };
 
 /* A table describing all the processors GCC knows about.  */
 static const struct riscv_cpu_info riscv_cpu_info_table[] = {
   /* Entries for generic ISAs.  */
-  { "rocket", "IMAFD", &rocket_tune_info },
+  { "generic", "IMAFD", RISCV_UARCH_GENERIC, &generic_tune_info },
+
+  /* Entries for specific processors.  */
+  { "rocket", "IMAFD", RISCV_UARCH_ROCKET, &rocket_tune_info },
+  { "sifive-7-series", "IMAFDC", RISCV_UARCH_SIFIVE_7, &sifive_7_tune_info },
 };
 
 /* Return the riscv_cpu_info entry for the given name string.  */
@@ -346,91 +406,53 @@ riscv_parse_cpu (const char *cpu_string)
   return riscv_cpu_info_table;
 }
 
-/* Fill CODES with a sequence of rtl operations to load VALUE.
-   Return the number of operations needed.  */
+/* Fill CODES with a sequence of rtl operations to load VALUE in mode
+   MODE, or in word mode if MODE is VOIDmode.  Return the number of
+   operations needed.  The search itself is shared with GAS.  */
 
 static int
-riscv_build_integer_1 (struct mips_integer_op *codes, HOST_WIDE_INT value,
-		       enum machine_mode mode)
+riscv_build_integer (struct mips_integer_op *codes, HOST_WIDE_INT value,
+		     enum machine_mode mode)
 {
-  HOST_WIDE_INT low_part = RISCV_CONST_LOW_PART (value);
-  int cost = INT_MAX, alt_cost;
-  struct mips_integer_op alt_codes[RISCV_MAX_INTEGER_OPS];
+  struct riscv_const_op ops[RISCV_CONST_MAX_OPS];
+  int i, cost;
 
-  if (SMALL_OPERAND (value) || LUI_OPERAND (value))
-    {
-      /* Simply ADDI or LUI */
-      codes[0].code = UNKNOWN;
-      codes[0].value = value;
-      return 1;
-    }
+  cost = riscv_build_const (ops, value, (mode == VOIDmode
+					 ? BITS_PER_WORD
+					 : GET_MODE_BITSIZE (mode)));
+  gcc_assert (cost > 0);
 
-  /* End with ADDI */
-  if (low_part != 0
-      && !(mode == HImode && (int16_t)(value - low_part) != (value - low_part)))
+  for (i = 0; i < cost; i++)
     {
-      cost = 1 + riscv_build_integer_1 (codes, value - low_part, mode);
-      codes[cost-1].code = PLUS;
-      codes[cost-1].value = low_part;
-    }
+      codes[i].value = ops[i].value;
+      switch (ops[i].code)
+	{
+	case RISCV_CONST_LUI:
+	  codes[i].code = UNKNOWN;
+	  break;
 
-  /* End with XORI */
-  if (cost > 2 && (low_part < 0 || mode == HImode))
-    {
-      alt_cost = 1 + riscv_build_integer_1 (alt_codes, value ^ low_part, mode);
-      alt_codes[alt_cost-1].code = XOR;
-      alt_codes[alt_cost-1].value = low_part;
-      if (alt_cost < cost)
-	cost = alt_cost, memcpy (codes, alt_codes, sizeof(alt_codes));
-    }
+	case RISCV_CONST_ADDI:
+	  codes[i].code = i == 0 ? UNKNOWN : PLUS;
+	  break;
 
-  /* Eliminate trailing zeros and end with SLLI */
-  if (cost > 2 && (value & 1) == 0)
-    {
-      int shift = 0;
-      while ((value & 1) == 0)
-	shift++, value >>= 1;
-      alt_cost = 1 + riscv_build_integer_1 (alt_codes, value, mode);
-      alt_codes[alt_cost-1].code = ASHIFT;
-      alt_codes[alt_cost-1].value = shift;
-      if (alt_cost < cost)
-	cost = alt_cost, memcpy (codes, alt_codes, sizeof(alt_codes));
-    }
+	case RISCV_CONST_ADDIW:
+	  /* A 32-bit addition whose result is sign-extended to 64 bits;
+	     see mips_move_integer.  */
+	  codes[i].code = SIGN_EXTEND;
+	  break;
 
-  gcc_assert (cost <= RISCV_MAX_INTEGER_OPS);
-  return cost;
-}
+	case RISCV_CONST_XORI:
+	  codes[i].code = XOR;
+	  break;
 
-static int
-riscv_build_integer (struct mips_integer_op *codes, HOST_WIDE_INT value,
-		     enum machine_mode mode)
-{
-  int cost = riscv_build_integer_1 (codes, value, mode);
+	case RISCV_CONST_SLLI:
+	  codes[i].code = ASHIFT;
+	  break;
 
-  /* Eliminate leading zeros and end with SRLI */
-  if (value > 0 && cost > 2)
-    {
-      struct mips_integer_op alt_codes[RISCV_MAX_INTEGER_OPS];
-      int alt_cost, shift = 0;
-      HOST_WIDE_INT shifted_val;
-
-      /* Try filling trailing bits with 1s */
-      while ((value << shift) >= 0)
-	shift++;
-      shifted_val = (value << shift) | ((((HOST_WIDE_INT) 1) << shift) - 1);
-      alt_cost = 1 + riscv_build_integer_1 (alt_codes, shifted_val, mode);
-      alt_codes[alt_cost-1].code = LSHIFTRT;
-      alt_codes[alt_cost-1].value = shift;
-      if (alt_cost < cost)
-	cost = alt_cost, memcpy (codes, alt_codes, sizeof (alt_codes));
-
-      /* Try filling trailing bits with 0s */
-      shifted_val = value << shift;
-      alt_cost = 1 + riscv_build_integer_1 (alt_codes, shifted_val, mode);
-      alt_codes[alt_cost-1].code = LSHIFTRT;
-      alt_codes[alt_cost-1].value = shift;
-      if (alt_cost < cost)
-	cost = alt_cost, memcpy (codes, alt_codes, sizeof (alt_codes));
+	case RISCV_CONST_SRLI:
+	  codes[i].code = LSHIFTRT;
+	  break;
+	}
     }
 
   return cost;
@@ -833,8 +855,9 @@ riscv_const_insns (rtx x)
     case CONST_INT:
       {
 	int cost = riscv_integer_cost (INTVAL (x));
-	/* Force complicated constants to memory. */
-	return cost < 4 ? cost : 0;
+	/* Force complicated constants to memory; they will be loaded
+	   from .srodata.cst8.  */
+	return cost <= RISCV_CONST_POOL_INSNS ? cost : 0;
       }
 
     case CONST_DOUBLE:
@@ -1257,7 +1280,14 @@ mips_move_integer (rtx temp, rtx dest, HOST_WIDE_INT value)
           else
             x = force_reg (mode, x);
 
-          x = gen_rtx_fmt_ee (codes[i].code, mode, x, GEN_INT (codes[i].value));
+          if (codes[i].code == SIGN_EXTEND)
+            x = gen_rtx_SIGN_EXTEND (mode,
+				     gen_rtx_PLUS (SImode,
+						   gen_lowpart (SImode, x),
+						   GEN_INT (codes[i].value)));
+          else
+            x = gen_rtx_fmt_ee (codes[i].code, mode, x,
+				GEN_INT (codes[i].value));
         }
     }
 
@@ -1393,6 +1423,22 @@ riscv_binary_cost (rtx x, int single_insns, int double_insns)
   return COSTS_N_INSNS (single_insns);
 }
 
+/* Without the M extension, multiplication and division are libgcc
+   calls.  These are typical instruction counts for mul.S and div.S,
+   the latter being per bit of MODE.  */
+#define RISCV_MUL_LIBCALL_INSNS 40
+#define RISCV_DIV_LIBCALL_INSNS(MODE) (GET_MODE_BITSIZE (MODE) * 3)
+
+/* Return the cost of a libgcc call that executes INSNS instructions.
+   When optimizing for size, count the call and the argument and result
+   moves around it.  */
+
+static int
+riscv_libcall_cost (int insns, bool speed)
+{
+  return COSTS_N_INSNS (speed ? insns : 4);
+}
+
 /* Return the cost of sign-extending OP to mode MODE, not including the
    cost of OP itself.  */
 
@@ -1582,6 +1628,10 @@ riscv_rtx_costs (rtx x, int code, int outer_code, int opno ATTRIBUTE_UNUSED,
     case MULT:
       if (float_mode_p)
 	*total = tune_info->fp_mul[mode == DFmode];
+      else if (!TARGET_MULDIV)
+	*total = riscv_libcall_cost (GET_MODE_SIZE (mode) > UNITS_PER_WORD
+				     ? 4 * RISCV_MUL_LIBCALL_INSNS
+				     : RISCV_MUL_LIBCALL_INSNS, speed);
       else if (GET_MODE_SIZE (mode) > UNITS_PER_WORD)
 	*total = 3 * tune_info->int_mul[0] + COSTS_N_INSNS (2);
       else if (!speed)
@@ -1602,7 +1652,9 @@ riscv_rtx_costs (rtx x, int code, int outer_code, int opno ATTRIBUTE_UNUSED,
 
     case UDIV:
     case UMOD:
-      if (speed)
+      if (!TARGET_MULDIV)
+	*total = riscv_libcall_cost (RISCV_DIV_LIBCALL_INSNS (mode), speed);
+      else if (speed)
 	*total = tune_info->int_div[mode == DImode];
       else
 	*total = COSTS_N_INSNS (1);
@@ -2097,6 +2149,121 @@ riscv_expand_conditional_branch (rtx *operands)
   emit_jump_insn (gen_condjump (condition, operands[3]));
 }
 
+/* Reduce the comparison (*CODE *OP0 *OP1) to a test of a register
+   against zero, so that *CODE becomes EQ or NE and *OP1 becomes zero.
+   Return true if *OP0 is known to be 0 or 1.  */
+
+static bool
+riscv_emit_zero_compare (enum rtx_code *code, rtx *op0, rtx *op1)
+{
+  bool boolean_p = GET_MODE_CLASS (GET_MODE (*op0)) != MODE_INT;
+
+  mips_emit_compare (code, op0, op1);
+
+  if (*code == EQ || *code == NE)
+    *op0 = mips_zero_if_equal (*op0, *op1);
+  else
+    {
+      bool invert = false;
+      rtx target = gen_reg_rtx (GET_MODE (*op0));
+
+      mips_emit_int_order_test (*code, &invert, target, *op0, *op1);
+      *code = invert ? EQ : NE;
+      *op0 = target;
+      boolean_p = true;
+    }
+  *op1 = const0_rtx;
+  return boolean_p;
+}
+
+/* Set OPERANDS[0] to OPERANDS[2] if the comparison in OPERANDS[1] holds,
+   otherwise to OPERANDS[3].  Return false if a branch would be cheaper,
+   in which case nothing is emitted.
+
+   Xhwacha provides movz/movn and fmovz/fmovn, which copy their source
+   if a GPR is zero or nonzero respectively.  Without them, an integer
+   select is done with a mask: the 0/1 result of the comparison is
+   negated to give all-zeros or all-ones, and the arms are combined
+   as IF_FALSE ^ ((IF_TRUE ^ IF_FALSE) & MASK).  */
+
+bool
+riscv_expand_conditional_move (rtx *operands)
+{
+  rtx dest = operands[0];
+  enum machine_mode mode = GET_MODE (dest);
+  enum rtx_code code = GET_CODE (operands[1]);
+  rtx op0 = XEXP (operands[1], 0);
+  rtx op1 = XEXP (operands[1], 1);
+  rtx if_true = operands[2];
+  rtx if_false = operands[3];
+  rtx cond, mask, tmp, seq, insn;
+  unsigned int count;
+
+  if (TARGET_HWACHA)
+    {
+      riscv_emit_zero_compare (&code, &op0, &op1);
+      tmp = gen_reg_rtx (mode);
+      mips_emit_move (tmp, if_false);
+      cond = gen_rtx_fmt_ee (code, VOIDmode, op0, op1);
+      emit_insn (gen_rtx_SET (VOIDmode, tmp,
+			      gen_rtx_IF_THEN_ELSE (mode, cond, if_true, tmp)));
+      mips_emit_move (dest, tmp);
+      return true;
+    }
+
+  if (GET_MODE_CLASS (mode) != MODE_INT || !optimize_insn_for_speed_p ())
+    return false;
+
+  start_sequence ();
+
+  /* Set COND to 1 if the condition holds and 0 otherwise.  */
+  if (riscv_emit_zero_compare (&code, &op0, &op1)
+      && GET_MODE (op0) == mode)
+    cond = op0;
+  else
+    cond = mips_force_binary (mode, NE, op0, const0_rtx);
+  if (code == EQ)
+    {
+      tmp = if_true;
+      if_true = if_false;
+      if_false = tmp;
+    }
+
+  if (if_true == const0_rtx)
+    {
+      /* COND - 1 is all-ones exactly when IF_FALSE is wanted.  */
+      mask = mips_force_binary (mode, PLUS, cond, constm1_rtx);
+      mips_emit_binary (AND, dest, if_false, mask);
+    }
+  else
+    {
+      mask = gen_reg_rtx (mode);
+      emit_insn (gen_rtx_SET (VOIDmode, mask, gen_rtx_NEG (mode, cond)));
+      if (if_false == const0_rtx)
+	mips_emit_binary (AND, dest, if_true, mask);
+      else
+	{
+	  tmp = mips_force_binary (mode, XOR, if_true, if_false);
+	  tmp = mips_force_binary (mode, AND, tmp, mask);
+	  mips_emit_binary (XOR, dest, tmp, if_false);
+	}
+    }
+
+  seq = get_insns ();
+  end_sequence ();
+
+  /* Keep the branch if the select would take longer than the target
+     is prepared to spend avoiding one.  */
+  count = 0;
+  for (insn = seq; insn; insn = NEXT_INSN (insn))
+    count++;
+  if (count > tune_info->select_insns)
+    return false;
+
+  emit_insn (seq);
+  return true;
+}
+
 /* Implement TARGET_FUNCTION_ARG_BOUNDARY.  Every parameter gets at
    least PARM_BOUNDARY bits of alignment, but will be given anything up
    to STACK_BOUNDARY bits if the type requires it.  */
@@ -2573,9 +2740,13 @@ riscv_expand_call (bool sibcall_p, rtx result, rtx addr, rtx args_size)
 {
   rtx pattern;
 
+  /* Calls that can't use the PLT, including all external calls under
+     -mno-plt, load the target from the GOT.  Use a pseudo for normal
+     calls so that the load can be shared and hoisted out of loops; a
+     sibcall's target must survive the epilogue.  */
   if (!call_insn_operand (addr, VOIDmode))
     {
-      rtx reg = RISCV_EPILOGUE_TEMP (Pmode);
+      rtx reg = sibcall_p ? RISCV_EPILOGUE_TEMP (Pmode) : gen_reg_rtx (Pmode);
       mips_emit_move (reg, addr);
       addr = reg;
     }
@@ -2761,6 +2932,288 @@ riscv_expand_block_move (rtx dest, rtx src, rtx length)
   return false;
 }
 
+/* The maximum number of bytes that setmem will store with straight-line
+   code, and the number it stores per iteration of a loop; see
+   riscv_expand_block_set.  */
+#define RISCV_MAX_SET_BYTES_STRAIGHT (tune_info->set_words * UNITS_PER_WORD)
+#define RISCV_MAX_SET_BYTES_PER_LOOP_ITER (RISCV_MAX_SET_BYTES_STRAIGHT / 2)
+
+/* The maximum number of bytes that cmpmemsi will compare inline.  */
+#define RISCV_MAX_CMP_BYTES (tune_info->cmp_words * UNITS_PER_WORD)
+
+/* The number of words an inline strlen examines per loop iteration,
+   or 0 if strlen should never be expanded inline.  */
+#define RISCV_MAX_STRLEN_UNROLL (tune_info->strlen_unroll)
+
+/* Emit a branch to LABEL if (CODE OP0 OP1) holds.  */
+
+static void
+riscv_emit_branch (enum rtx_code code, rtx op0, rtx op1, rtx label)
+{
+  rtx operands[4];
+
+  operands[0] = gen_rtx_fmt_ee (code, VOIDmode, op0, op1);
+  operands[1] = op0;
+  operands[2] = op1;
+  operands[3] = label;
+  riscv_expand_conditional_branch (operands);
+}
+
+/* Return a word_mode value with every byte equal to the low byte of
+   VALUE, forced into a register unless it is zero.  */
+
+static rtx
+riscv_replicate_byte (rtx value)
+{
+  rtx word;
+  int shift;
+
+  if (CONST_INT_P (value))
+    {
+      unsigned HOST_WIDE_INT byte = INTVAL (value) & 0xff;
+      HOST_WIDE_INT rep = byte * ((unsigned HOST_WIDE_INT) -1 / 0xff);
+
+      if (byte == 0)
+	return const0_rtx;
+      return force_reg (word_mode, GEN_INT (trunc_int_for_mode (rep,
+								  word_mode)));
+    }
+
+  word = force_reg (word_mode, convert_to_mode (word_mode, value, 1));
+  for (shift = BITS_PER_UNIT; shift < BITS_PER_WORD; shift *= 2)
+    word = mips_force_binary (word_mode, IOR, word,
+			      mips_force_binary (word_mode, ASHIFT, word,
+						 GEN_INT (shift)));
+  return word;
+}
+
+/* Emit straight-line code to store LENGTH bytes of DEST, each equal
+   to a byte of VALUE, a word returned by riscv_replicate_byte.  */
+
+static void
+riscv_block_set_straight (rtx dest, rtx value, HOST_WIDE_INT length)
+{
+  HOST_WIDE_INT offset, delta;
+  enum machine_mode mode;
+
+  delta = MAX (BITS_PER_UNIT, MIN (BITS_PER_WORD, MEM_ALIGN (dest)))
+	  / BITS_PER_UNIT;
+
+  /* Store DELTA-sized chunks, then mop up the tail with successively
+     smaller ones, each of which stays naturally aligned.  */
+  for (offset = 0; offset < length; delta /= 2)
+    {
+      mode = mode_for_size (delta * BITS_PER_UNIT, MODE_INT, 0);
+      for (; offset + delta <= length; offset += delta)
+	mips_emit_move (adjust_address (dest, mode, offset),
+			value == const0_rtx ? value
+			: gen_lowpart (mode, value));
+    }
+}
+
+/* Store LENGTH bytes of DEST using a loop that stores BYTES_PER_ITER
+   bytes at a time.  LENGTH must be at least BYTES_PER_ITER.  */
+
+static void
+riscv_block_set_loop (rtx dest, rtx value, HOST_WIDE_INT length,
+		      HOST_WIDE_INT bytes_per_iter)
+{
+  rtx label, dest_reg, final_dest;
+  HOST_WIDE_INT leftover;
+
+  leftover = length % bytes_per_iter;
+  length -= leftover;
+
+  mips_adjust_block_mem (dest, bytes_per_iter, &dest_reg, &dest);
+  final_dest = expand_simple_binop (Pmode, PLUS, dest_reg, GEN_INT (length),
+				    0, 0, OPTAB_WIDEN);
+
+  label = gen_label_rtx ();
+  emit_label (label);
+
+  riscv_block_set_straight (dest, value, bytes_per_iter);
+  mips_emit_move (dest_reg, plus_constant (Pmode, dest_reg, bytes_per_iter));
+  riscv_emit_branch (NE, dest_reg, final_dest, label);
+
+  if (leftover)
+    riscv_block_set_straight (dest, value, leftover);
+}
+
+/* Expand a setmem instruction, which sets LENGTH bytes of memory
+   reference DEST to the byte VALUE.  */
+
+bool
+riscv_expand_block_set (rtx dest, rtx length, rtx value)
+{
+  HOST_WIDE_INT factor, align;
+
+  if (!CONST_INT_P (length) || INTVAL (length) <= 0)
+    return false;
+
+  align = MIN (MEM_ALIGN (dest), BITS_PER_WORD);
+  factor = BITS_PER_WORD / align;
+
+  if (INTVAL (length) <= RISCV_MAX_SET_BYTES_STRAIGHT / factor)
+    {
+      riscv_block_set_straight (dest, riscv_replicate_byte (value),
+				INTVAL (length));
+      return true;
+    }
+  else if (optimize && align >= BITS_PER_WORD
+	   && RISCV_MAX_SET_BYTES_PER_LOOP_ITER >= UNITS_PER_WORD)
+    {
+      riscv_block_set_loop (dest, riscv_replicate_byte (value),
+			    INTVAL (length),
+			    RISCV_MAX_SET_BYTES_PER_LOOP_ITER);
+      return true;
+    }
+  return false;
+}
+
+/* Expand a cmpmemsi instruction, which sets RESULT to the memcmp of
+   the LENGTH bytes at SRC1 and SRC2.  ALIGN is the known alignment of
+   both, in bytes.
+
+   Compare a word at a time, branching out on the first mismatch.
+   Only then shift both words right a byte at a time until the
+   lowest-addressed differing byte is found.  */
+
+bool
+riscv_expand_block_compare (rtx result, rtx src1, rtx src2, rtx length,
+			    rtx align)
+{
+  HOST_WIDE_INT offset, delta, bytes;
+  rtx a, b, diff, mismatch, found, done;
+  enum machine_mode mode;
+
+  if (!CONST_INT_P (length)
+      || INTVAL (length) <= 0
+      || INTVAL (length) > RISCV_MAX_CMP_BYTES
+      || INTVAL (align) < UNITS_PER_WORD
+      || !optimize_insn_for_speed_p ())
+    return false;
+
+  bytes = INTVAL (length);
+  a = gen_reg_rtx (word_mode);
+  b = gen_reg_rtx (word_mode);
+  mismatch = gen_label_rtx ();
+  found = gen_label_rtx ();
+  done = gen_label_rtx ();
+
+  /* Narrower tail chunks are zero-extended, so they compare correctly
+     as words too.  */
+  for (offset = 0, delta = UNITS_PER_WORD; offset < bytes; delta /= 2)
+    {
+      mode = mode_for_size (delta * BITS_PER_UNIT, MODE_INT, 0);
+      for (; offset + delta <= bytes; offset += delta)
+	{
+	  rtx m1 = adjust_address (src1, mode, offset);
+	  rtx m2 = adjust_address (src2, mode, offset);
+
+	  if (mode == word_mode)
+	    {
+	      mips_emit_move (a, m1);
+	      mips_emit_move (b, m2);
+	    }
+	  else
+	    {
+	      emit_insn (gen_rtx_SET (VOIDmode, a,
+				      gen_rtx_ZERO_EXTEND (word_mode, m1)));
+	      emit_insn (gen_rtx_SET (VOIDmode, b,
+				      gen_rtx_ZERO_EXTEND (word_mode, m2)));
+	    }
+	  riscv_emit_branch (NE, a, b, mismatch);
+	}
+    }
+
+  mips_emit_move (result, const0_rtx);
+  emit_jump_insn (gen_jump (done));
+  emit_barrier ();
+
+  /* A and B differ; skip over their equal low-order bytes.  */
+  emit_label (mismatch);
+  diff = mips_force_binary (word_mode, XOR, a, b);
+  diff = mips_force_binary (word_mode, AND, diff, GEN_INT (0xff));
+  riscv_emit_branch (NE, diff, const0_rtx, found);
+  mips_emit_binary (LSHIFTRT, a, a, GEN_INT (BITS_PER_UNIT));
+  mips_emit_binary (LSHIFTRT, b, b, GEN_INT (BITS_PER_UNIT));
+  emit_jump_insn (gen_jump (mismatch));
+  emit_barrier ();
+
+  emit_label (found);
+  mips_emit_binary (AND, a, a, GEN_INT (0xff));
+  mips_emit_binary (AND, b, b, GEN_INT (0xff));
+  diff = mips_force_binary (word_mode, MINUS, a, b);
+  mips_emit_move (result, gen_lowpart (GET_MODE (result), diff));
+
+  emit_label (done);
+  return true;
+}
+
+/* Expand a strlen instruction, which sets RESULT to the length of
+   the string at SRC.  ALIGN is the known alignment of SRC in bytes
+   and EOS the character searched for.
+
+   Scan a word at a time, like the C library's strlen.  A word W holds
+   a zero byte iff ~(((W & M) + M) | W | M) is nonzero, where M is
+   0x7f in every byte; the result then has bit 7 set in each zero byte
+   and no other bits set.  */
+
+bool
+riscv_expand_strlen (rtx result, rtx src, rtx eos, rtx align)
+{
+  rtx addr, start, mask, word, nul, loop, found, scan, end;
+  int i;
+
+  if (eos != const0_rtx
+      || INTVAL (align) < UNITS_PER_WORD
+      || RISCV_MAX_STRLEN_UNROLL == 0
+      || !optimize_insn_for_speed_p ())
+    return false;
+
+  start = force_reg (Pmode, XEXP (src, 0));
+  addr = gen_reg_rtx (Pmode);
+  mips_emit_move (addr, start);
+  mask = riscv_replicate_byte (GEN_INT (0x7f));
+  nul = gen_reg_rtx (word_mode);
+  loop = gen_label_rtx ();
+  found = gen_label_rtx ();
+
+  emit_label (loop);
+  for (i = 0; i < RISCV_MAX_STRLEN_UNROLL; i++)
+    {
+      word = gen_reg_rtx (word_mode);
+      mips_emit_move (word, change_address (src, word_mode, addr));
+      mips_emit_move (addr, plus_constant (Pmode, addr, UNITS_PER_WORD));
+      mips_emit_binary (AND, nul, word, mask);
+      mips_emit_binary (PLUS, nul, nul, mask);
+      mips_emit_binary (IOR, nul, nul, word);
+      mips_emit_binary (IOR, nul, nul, mask);
+      emit_insn (gen_rtx_SET (VOIDmode, nul, gen_rtx_NOT (word_mode, nul)));
+      if (i + 1 < RISCV_MAX_STRLEN_UNROLL)
+	riscv_emit_branch (NE, nul, const0_rtx, found);
+      else
+	riscv_emit_branch (EQ, nul, const0_rtx, loop);
+    }
+
+  /* ADDR is just past the word holding the terminator.  Step RESULT
+     through it until NUL's low byte is the flagged one.  */
+  emit_label (found);
+  mips_emit_binary (MINUS, result, addr, start);
+  mips_emit_move (result, plus_constant (Pmode, result, -UNITS_PER_WORD));
+  scan = gen_label_rtx ();
+  end = gen_label_rtx ();
+  emit_label (scan);
+  word = mips_force_binary (word_mode, AND, nul, GEN_INT (0x80));
+  riscv_emit_branch (NE, word, const0_rtx, end);
+  mips_emit_binary (LSHIFTRT, nul, nul, GEN_INT (BITS_PER_UNIT));
+  mips_emit_move (result, plus_constant (Pmode, result, 1));
+  emit_jump_insn (gen_jump (scan));
+  emit_barrier ();
+  emit_label (end);
+  return true;
+}
+
 /* (Re-)Initialize riscv_lo_relocs and riscv_hi_relocs.  */
 
 static void
@@ -3034,6 +3487,53 @@ riscv_save_reg_p (unsigned int regno)
 	 || (regno == RETURN_ADDR_REGNUM && crtl->calls_eh_return);
 }
 
+/* Return N such that __riscv_save_N saves every s-register in MASK.  */
+
+static unsigned int
+riscv_save_libcall_count (unsigned int mask)
+{
+  unsigned int regno;
+
+  for (regno = GP_REG_LAST; regno > GP_REG_FIRST; regno--)
+    if (BITSET_P (mask, regno - GP_REG_FIRST)
+	&& CALLEE_SAVED_REG_NUMBER (regno) >= 0)
+      return CALLEE_SAVED_REG_NUMBER (regno) + 1;
+
+  return 0;
+}
+
+/* Return the mask of GPRs that __riscv_save_N saves: the return
+   address and s0 to s(N-1).  */
+
+static unsigned int
+riscv_save_libcall_mask (unsigned int n)
+{
+  unsigned int regno, mask;
+
+  mask = 1 << (RETURN_ADDR_REGNUM - GP_REG_FIRST);
+  for (regno = GP_REG_FIRST; regno <= GP_REG_LAST; regno++)
+    if (CALLEE_SAVED_REG_NUMBER (regno) >= 0
+	&& CALLEE_SAVED_REG_NUMBER (regno) < (int) n)
+      mask |= 1 << (regno - GP_REG_FIRST);
+
+  return mask;
+}
+
+/* Return true if the current function may save and restore its GPRs
+   with the -msave-restore routines.  They are called through t0, which
+   rules out functions that take a static chain, and they allocate the
+   GPR save area themselves, so it must be at the top of the frame.  */
+
+static bool
+riscv_save_libcall_ok_p (void)
+{
+  return (TARGET_SAVE_RESTORE
+	  && !crtl->calls_eh_return
+	  && !cfun->static_chain_decl
+	  && cfun->machine->varargs_size == 0
+	  && crtl->args.pretend_args_size == 0);
+}
+
 /* Populate the current function's riscv_frame_info structure.
 
    RISC-V stack frames grown downward.  High addresses are at the top.
@@ -3104,6 +3604,27 @@ riscv_compute_frame_info (void)
       if (riscv_save_reg_p (regno))
         frame->fmask |= 1 << (regno - FP_REG_FIRST);
 
+  /* Use the save/restore routines if they cover the GPRs we need without
+     making the save area any bigger.  The routines save registers in the
+     same order that we do, so also save the extra registers they do.  */
+  if (frame->mask && riscv_save_libcall_ok_p ())
+    {
+      unsigned int libcall_mask;
+      HOST_WIDE_INT libcall_size;
+
+      libcall_mask
+	= riscv_save_libcall_mask (riscv_save_libcall_count (frame->mask));
+      libcall_size = RISCV_STACK_ALIGN (__builtin_popcount (libcall_mask)
+					* UNITS_PER_WORD);
+      if ((frame->mask & ~libcall_mask) == 0
+	  && libcall_size == RISCV_STACK_ALIGN (__builtin_popcount (frame->mask)
+						* UNITS_PER_WORD))
+	{
+	  frame->mask = libcall_mask;
+	  frame->save_libcall_adjustment = libcall_size;
+	}
+    }
+
   /* At the bottom of the frame are any outgoing stack arguments. */
   offset = crtl->outgoing_args_size;
   /* Next are local stack variables. */
@@ -3217,12 +3738,12 @@ mips_save_restore_reg (enum machine_mode mode, int regno,
   fn (gen_rtx_REG (mode, regno), mem);
 }
 
-/* Call FN for each register that is saved by the current function.
-   SP_OFFSET is the offset of the current stack pointer from the start
-   of the frame.  */
+/* Call FN for each register that is saved by the current function,
+   except for GPRs that are not in MASK.  SP_OFFSET is the offset of the
+   current stack pointer from the start of the frame.  */
 
 static void
-riscv_for_each_saved_gpr_and_fpr (HOST_WIDE_INT sp_offset,
+riscv_for_each_saved_gpr_and_fpr (HOST_WIDE_INT sp_offset, unsigned int mask,
 				 mips_save_restore_fn fn)
 {
   HOST_WIDE_INT offset;
@@ -3233,7 +3754,8 @@ riscv_for_each_saved_gpr_and_fpr (HOST_WIDE_INT sp_offset,
   for (regno = GP_REG_FIRST; regno <= GP_REG_LAST-1; regno++)
     if (BITSET_P (cfun->machine->frame.mask, regno - GP_REG_FIRST))
       {
-        mips_save_restore_reg (word_mode, regno, offset, fn);
+	if (BITSET_P (mask, regno - GP_REG_FIRST))
+	  mips_save_restore_reg (word_mode, regno, offset, fn);
         offset -= UNITS_PER_WORD;
       }
 
@@ -3293,6 +3815,40 @@ riscv_save_reg (rtx reg, rtx mem)
   riscv_emit_save_slot_move (mem, reg, RISCV_PROLOGUE_TEMP (GET_MODE (reg)));
 }
 
+/* Emit a call to __riscv_save_N for the current function's GPRs, and
+   describe its effect on the stack pointer and the save slots.  */
+
+static void
+riscv_emit_gpr_save (const struct riscv_frame_info *frame)
+{
+  HOST_WIDE_INT offset;
+  rtx dwarf, mem, set;
+  int regno, i;
+
+  emit_insn (gen_gpr_save (GEN_INT (riscv_save_libcall_count (frame->mask))));
+
+  dwarf = gen_rtx_PARALLEL (VOIDmode,
+			    rtvec_alloc (1 + __builtin_popcount (frame->mask)));
+  set = gen_rtx_SET (VOIDmode, stack_pointer_rtx,
+		     plus_constant (Pmode, stack_pointer_rtx,
+				    -frame->save_libcall_adjustment));
+  RTX_FRAME_RELATED_P (set) = 1;
+  XVECEXP (dwarf, 0, 0) = set;
+
+  i = 1;
+  offset = frame->save_libcall_adjustment - UNITS_PER_WORD;
+  for (regno = GP_REG_FIRST; regno <= GP_REG_LAST-1; regno++)
+    if (BITSET_P (frame->mask, regno - GP_REG_FIRST))
+      {
+	mem = gen_frame_mem (word_mode,
+			     plus_constant (Pmode, stack_pointer_rtx, offset));
+	XVECEXP (dwarf, 0, i++)
+	  = mips_frame_set (mem, gen_rtx_REG (word_mode, regno));
+	offset -= UNITS_PER_WORD;
+      }
+
+  mips_set_frame_expr (dwarf);
+}
 
 /* Expand the "prologue" pattern.  */
 
@@ -3315,14 +3871,26 @@ riscv_expand_prologue (void)
   if ((frame->mask | frame->fmask) != 0)
     {
       HOST_WIDE_INT step1;
+      unsigned int mask = frame->mask;
 
-      step1 = MIN (size, RISCV_MAX_FIRST_STACK_STEP);
-      insn = gen_add3_insn (stack_pointer_rtx,
-			    stack_pointer_rtx,
-			    GEN_INT (-step1));
-      RTX_FRAME_RELATED_P (emit_insn (insn)) = 1;
-      size -= step1;
-      riscv_for_each_saved_gpr_and_fpr (size, riscv_save_reg);
+      /* The save routine allocates and fills the GPR save area.  */
+      if (frame->save_libcall_adjustment != 0)
+	{
+	  riscv_emit_gpr_save (frame);
+	  size -= frame->save_libcall_adjustment;
+	  mask = 0;
+	}
+
+      if ((mask | frame->fmask) != 0)
+	{
+	  step1 = MIN (size, RISCV_MAX_FIRST_STACK_STEP);
+	  insn = gen_add3_insn (stack_pointer_rtx,
+				stack_pointer_rtx,
+				GEN_INT (-step1));
+	  RTX_FRAME_RELATED_P (emit_insn (insn)) = 1;
+	  size -= step1;
+	  riscv_for_each_saved_gpr_and_fpr (size, mask, riscv_save_reg);
+	}
     }
 
   /* Set up the frame pointer, if we're using one.  */
@@ -3354,13 +3922,78 @@ riscv_expand_prologue (void)
 	}
     }
 }
-
+
+/* Information about the current function's epilogue, used only while
+   expanding it.  The epilogue must describe its effect on the CFA so
+   that shrink-wrapped functions, whose epilogues need not come last,
+   get correct unwind information for the code that follows.  */
+
+static struct {
+  /* A list of queued REG_CFA_RESTORE notes.  */
+  rtx cfa_restores;
+
+  /* The CFA is currently defined as CFA_REG + CFA_OFFSET.  */
+  rtx cfa_reg;
+  HOST_WIDE_INT cfa_offset;
+
+  /* The offset of the CFA from the stack pointer while restoring
+     registers.  */
+  HOST_WIDE_INT cfa_restore_sp_offset;
+} riscv_epilogue;
+
+/* Attach any queued REG_CFA_RESTORE notes to the last instruction.  */
+
+static void
+riscv_epilogue_emit_cfa_restores (void)
+{
+  rtx insn;
+
+  insn = get_last_insn ();
+  gcc_assert (insn && !REG_NOTES (insn));
+  if (riscv_epilogue.cfa_restores)
+    {
+      RTX_FRAME_RELATED_P (insn) = 1;
+      REG_NOTES (insn) = riscv_epilogue.cfa_restores;
+      riscv_epilogue.cfa_restores = 0;
+    }
+}
+
+/* Redefine the CFA as REG + OFFSET after the last instruction, along
+   with any queued REG_CFA_RESTORE notes.  */
+
+static void
+riscv_epilogue_set_cfa (rtx reg, HOST_WIDE_INT offset)
+{
+  rtx insn;
+
+  insn = get_last_insn ();
+  gcc_assert (insn && !REG_NOTES (insn));
+  if (reg != riscv_epilogue.cfa_reg || offset != riscv_epilogue.cfa_offset)
+    {
+      RTX_FRAME_RELATED_P (insn) = 1;
+      REG_NOTES (insn) = alloc_reg_note (REG_CFA_DEF_CFA,
+					 plus_constant (Pmode, reg, offset),
+					 riscv_epilogue.cfa_restores);
+      riscv_epilogue.cfa_restores = 0;
+      riscv_epilogue.cfa_reg = reg;
+      riscv_epilogue.cfa_offset = offset;
+    }
+}
+
 /* Emit instructions to restore register REG from slot MEM.  */
 
 static void
 riscv_restore_reg (rtx reg, rtx mem)
 {
   riscv_emit_save_slot_move (reg, mem, RISCV_EPILOGUE_TEMP (GET_MODE (reg)));
+  riscv_epilogue.cfa_restores = alloc_reg_note (REG_CFA_RESTORE, reg,
+						riscv_epilogue.cfa_restores);
+
+  /* If the CFA is defined in terms of REG, redefine it in terms of
+     the stack pointer.  */
+  if (REGNO (reg) == REGNO (riscv_epilogue.cfa_reg))
+    riscv_epilogue_set_cfa (stack_pointer_rtx,
+			    riscv_epilogue.cfa_restore_sp_offset);
 }
 
 /* Expand an "epilogue" or "sibcall_epilogue" pattern; SIBCALL_P
@@ -3370,7 +4003,8 @@ void
 riscv_expand_epilogue (bool sibcall_p)
 {
   const struct riscv_frame_info *frame;
-  HOST_WIDE_INT step1, step2;
+  HOST_WIDE_INT step1, step2, libcall_size;
+  unsigned int mask;
 
   if (!sibcall_p && riscv_can_use_return_insn ())
     {
@@ -3378,13 +4012,33 @@ riscv_expand_epilogue (bool sibcall_p)
       return;
     }
 
+  frame = &cfun->machine->frame;
+
+  /* __riscv_restore_N returns to our caller, so sibling calls must
+     restore the GPRs themselves.  */
+  libcall_size = sibcall_p ? 0 : frame->save_libcall_adjustment;
+  mask = libcall_size != 0 ? 0 : frame->mask;
+
+  riscv_epilogue.cfa_restores = 0;
+  if (frame_pointer_needed)
+    {
+      riscv_epilogue.cfa_reg = hard_frame_pointer_rtx;
+      riscv_epilogue.cfa_offset
+	= frame->total_size - frame->hard_frame_pointer_offset;
+    }
+  else
+    {
+      riscv_epilogue.cfa_reg = stack_pointer_rtx;
+      riscv_epilogue.cfa_offset = frame->total_size;
+    }
+
   /* Split the frame into two.  STEP1 is the amount of stack we should
      deallocate before restoring the registers.  STEP2 is the amount we
-     should deallocate afterwards.
+     should deallocate afterwards.  Any GPR save area belonging to the
+     restore routine is left for it to deallocate.
 
      Start off by assuming that no registers need to be restored.  */
-  frame = &cfun->machine->frame;
-  step1 = frame->total_size;
+  step1 = frame->total_size - libcall_size;
   step2 = 0;
 
   /* Move past any dynamic stack allocations. */
@@ -3398,11 +4052,12 @@ riscv_expand_epilogue (bool sibcall_p)
 	}
 
       emit_insn (gen_add3_insn (stack_pointer_rtx, hard_frame_pointer_rtx, adjust));
+      riscv_epilogue_set_cfa (stack_pointer_rtx, frame->total_size);
     }
 
   /* If we need to restore registers, deallocate as much stack as
      possible in the second step without going out of range.  */
-  if ((frame->mask | frame->fmask) != 0)
+  if ((mask | frame->fmask) != 0)
     {
       step2 = MIN (step1, RISCV_MAX_FIRST_STACK_STEP);
       step1 -= step2;
@@ -3420,23 +4075,37 @@ riscv_expand_epilogue (bool sibcall_p)
 	}
 
       emit_insn (gen_add3_insn (stack_pointer_rtx, stack_pointer_rtx, adjust));
+      riscv_epilogue_set_cfa (stack_pointer_rtx, step2 + libcall_size);
     }
 
   /* Restore the registers.  */
-  riscv_for_each_saved_gpr_and_fpr (frame->total_size - step2,
-				    riscv_restore_reg);
+  riscv_epilogue.cfa_restore_sp_offset = step2 + libcall_size;
+  riscv_for_each_saved_gpr_and_fpr (frame->total_size - libcall_size - step2,
+				    mask, riscv_restore_reg);
 
   /* Deallocate the final bit of the frame.  */
   if (step2 > 0)
-    emit_insn (gen_add3_insn (stack_pointer_rtx, stack_pointer_rtx,
-			      GEN_INT (step2)));
+    {
+      emit_insn (gen_add3_insn (stack_pointer_rtx, stack_pointer_rtx,
+				GEN_INT (step2)));
+      riscv_epilogue_set_cfa (stack_pointer_rtx, libcall_size);
+    }
+  else if (riscv_epilogue.cfa_restores)
+    riscv_epilogue_emit_cfa_restores ();
 
   /* Add in the __builtin_eh_return stack adjustment. */
   if (crtl->calls_eh_return)
     emit_insn (gen_add3_insn (stack_pointer_rtx, stack_pointer_rtx,
 			      EH_RETURN_STACKADJ_RTX));
 
-  if (!sibcall_p)
+  if (libcall_size != 0)
+    {
+      rtx ra = gen_rtx_REG (Pmode, RETURN_ADDR_REGNUM);
+      emit_insn (gen_gpr_restore
+		 (GEN_INT (riscv_save_libcall_count (frame->mask))));
+      emit_jump_insn (gen_gpr_restore_return (ra));
+    }
+  else if (!sibcall_p)
     {
       rtx ra = gen_rtx_REG (Pmode, RETURN_ADDR_REGNUM);
       emit_jump_insn (gen_simple_return_internal (ra));
@@ -3639,13 +4308,18 @@ mips_scalar_mode_supported_p (enum machine_mode mode)
   return default_scalar_mode_supported_p (mode);
 }
 
-/* Implement TARGET_SCHED_ADJUST_COST.  We assume that anti and output
-   dependencies have no cost. */
+/* Implement TARGET_SCHED_ADJUST_COST.  We assume that anti dependencies
+   have no cost.  Output dependencies are free on single-issue cores, but
+   a multi-issue in-order core cannot retire two writes to the same
+   register from one issue packet, so keep them a cycle apart there.
+   True dependencies use the latency from the pipeline description.  */
 
 static int
 mips_adjust_cost (rtx insn ATTRIBUTE_UNUSED, rtx link,
 		  rtx dep ATTRIBUTE_UNUSED, int cost)
 {
+  if (REG_NOTE_KIND (link) == REG_DEP_OUTPUT)
+    return tune_info->issue_rate > 1 ? 1 : 0;
   if (REG_NOTE_KIND (link) != 0)
     return 0;
   return cost;
@@ -3659,6 +4333,16 @@ riscv_issue_rate (void)
   return tune_info->issue_rate;
 }
 
+/* Implement TARGET_SCHED_FIRST_CYCLE_MULTIPASS_DFA_LOOKAHEAD.  Looking
+   ahead lets the scheduler pick a pair that can dual-issue rather than
+   greedily taking the first ready instruction.  */
+
+static int
+riscv_multipass_dfa_lookahead (void)
+{
+  return tune_info->issue_rate > 1 ? tune_info->issue_rate * 2 : 0;
+}
+
 /* This structure describes a single built-in function.  */
 struct mips_builtin_description {
   /* The code of the main .md file instruction.  See mips_builtin_type
@@ -3684,6 +4368,12 @@ mips_builtin_avail_riscv (void)
   return 1;
 }
 
+static unsigned int
+mips_builtin_avail_hwacha (void)
+{
+  return TARGET_HWACHA;
+}
+
 /* Construct a mips_builtin_description from the given arguments.
 
    INSN is the name of the associated instruction pattern, without the
@@ -3716,8 +4406,51 @@ mips_builtin_avail_riscv (void)
   RISCV_BUILTIN (INSN, #INSN, RISCV_BUILTIN_DIRECT_NO_TARGET,		\
 		FUNCTION_TYPE, AVAIL)
 
+/* Define __builtin_riscv_<INSN> for the Xhwacha instruction INSN, which
+   is implemented by pattern hwacha_<INSN>.  The first form returns a value
+   and the second does not.  */
+#define HWACHA_BUILTIN(INSN, FUNCTION_TYPE)				\
+  RISCV_BUILTIN (hwacha_ ## INSN, #INSN, RISCV_BUILTIN_DIRECT,		\
+		FUNCTION_TYPE, hwacha)
+
+#define HWACHA_NO_TARGET_BUILTIN(INSN, FUNCTION_TYPE)			\
+  RISCV_BUILTIN (hwacha_ ## INSN, #INSN, RISCV_BUILTIN_DIRECT_NO_TARGET,	\
+		FUNCTION_TYPE, hwacha)
+
+/* Define the unit-stride and strided forms of a vector load.  */
+#define HWACHA_LOAD_BUILTINS(INSN, STRIDED_INSN)			\
+  HWACHA_NO_TARGET_BUILTIN (INSN, RISCV_VOID_FTYPE_USI_CPOINTER),	\
+  HWACHA_NO_TARGET_BUILTIN (STRIDED_INSN,				\
+			    RISCV_VOID_FTYPE_USI_CPOINTER_LONG)
+
+/* Likewise for vector stores.  */
+#define HWACHA_STORE_BUILTINS(INSN, STRIDED_INSN)			\
+  HWACHA_NO_TARGET_BUILTIN (INSN, RISCV_VOID_FTYPE_USI_POINTER),	\
+  HWACHA_NO_TARGET_BUILTIN (STRIDED_INSN, RISCV_VOID_FTYPE_USI_POINTER_LONG)
+
 static const struct mips_builtin_description mips_builtins[] = {
   DIRECT_NO_TARGET_BUILTIN (nop, RISCV_VOID_FTYPE_VOID, riscv),
+
+  HWACHA_NO_TARGET_BUILTIN (vsetcfg, RISCV_VOID_FTYPE_USI_USI),
+  HWACHA_BUILTIN (vsetvl, RISCV_USI_FTYPE_USI),
+  HWACHA_BUILTIN (vgetvl, RISCV_USI_FTYPE_VOID),
+  HWACHA_NO_TARGET_BUILTIN (vmsv, RISCV_VOID_FTYPE_USI_ULONG),
+  HWACHA_NO_TARGET_BUILTIN (vf, RISCV_VOID_FTYPE_CPOINTER),
+  HWACHA_LOAD_BUILTINS (vld, vlstd),
+  HWACHA_LOAD_BUILTINS (vlw, vlstw),
+  HWACHA_LOAD_BUILTINS (vlwu, vlstwu),
+  HWACHA_LOAD_BUILTINS (vlh, vlsth),
+  HWACHA_LOAD_BUILTINS (vlhu, vlsthu),
+  HWACHA_LOAD_BUILTINS (vlb, vlstb),
+  HWACHA_LOAD_BUILTINS (vlbu, vlstbu),
+  HWACHA_LOAD_BUILTINS (vfld, vflstd),
+  HWACHA_LOAD_BUILTINS (vflw, vflstw),
+  HWACHA_STORE_BUILTINS (vsd, vsstd),
+  HWACHA_STORE_BUILTINS (vsw, vsstw),
+  HWACHA_STORE_BUILTINS (vsh, vssth),
+  HWACHA_STORE_BUILTINS (vsb, vsstb),
+  HWACHA_STORE_BUILTINS (vfsd, vfsstd),
+  HWACHA_STORE_BUILTINS (vfsw, vfsstw),
 };
 
 /* Index I is the function declaration for mips_builtins[I], or null if the
@@ -3730,6 +4463,8 @@ static GTY(()) tree mips_builtin_decls[ARRAY_SIZE (mips_builtins)];
 #define RISCV_ATYPE_INT integer_type_node
 #define RISCV_ATYPE_POINTER ptr_type_node
 #define RISCV_ATYPE_CPOINTER const_ptr_type_node
+#define RISCV_ATYPE_LONG long_integer_type_node
+#define RISCV_ATYPE_ULONG long_unsigned_type_node
 
 /* Standard mode-based argument types.  */
 #define RISCV_ATYPE_UQI unsigned_intQI_type_node
@@ -4059,6 +4794,7 @@ mips_option_override (void)
   /* Handle -mtune.  */
   cpu = riscv_parse_cpu (riscv_tune_string ? riscv_tune_string :
 			 RISCV_TUNE_STRING_DEFAULT);
+  riscv_microarchitecture = cpu->microarchitecture;
   tune_info = optimize_size ? &optimize_size_tune_info : cpu->tune_info;
 
   /* If the user hasn't specified a branch cost, use the processor's
@@ -4175,6 +4911,9 @@ riscv_lra_p (void)
 #define TARGET_SCHED_ADJUST_COST mips_adjust_cost
 #undef TARGET_SCHED_ISSUE_RATE
 #define TARGET_SCHED_ISSUE_RATE riscv_issue_rate
+#undef TARGET_SCHED_FIRST_CYCLE_MULTIPASS_DFA_LOOKAHEAD
+#define TARGET_SCHED_FIRST_CYCLE_MULTIPASS_DFA_LOOKAHEAD \
+  riscv_multipass_dfa_lookahead
 
 #undef TARGET_FUNCTION_OK_FOR_SIBCALL
 #define TARGET_FUNCTION_OK_FOR_SIBCALL hook_bool_tree_tree_true
@@ -58,6 +58,12 @@ along with GCC; see the file COPYING3.  If not see
         builtin_define ("__riscv_atomic");                              \
       }                                                                 \
                                                                         \
+      if (TARGET_MULDIV)						\
+	builtin_define ("__riscv_muldiv");				\
+                                                                        \
+      if (TARGET_HWACHA)						\
+	builtin_define ("__riscv_hwacha");				\
+                                                                        \
       /* These defines reflect the ABI in use, not whether the  	\
 	 FPU is directly accessible.  */				\
       if (TARGET_HARD_FLOAT_ABI) {					\
@@ -168,6 +174,7 @@ along with GCC; see the file COPYING3.  If not see
 %{m32} %{m64} %{!m32:%{!m64: %(asm_abi_default_spec)}} \
 %{fPIC|fpic|fPIE|fpie:-fpic} \
 %{march=*} \
+%{mhwacha:%{!march=*:-march=IMAFDXhwacha}} \
 %(subtarget_asm_spec)"
 
 /* Extra switches sometimes passed to the linker.  */
@@ -510,6 +517,13 @@ along with GCC; see the file COPYING3.  If not see
 #define RISCV_PROLOGUE_TEMP(MODE) gen_rtx_REG (MODE, RISCV_PROLOGUE_TEMP_REGNUM)
 #define RISCV_EPILOGUE_TEMP(MODE) gen_rtx_REG (MODE, RISCV_EPILOGUE_TEMP_REGNUM)
 
+/* The index of call-saved register REGNO among s0-s11, or -1 if it is
+   not one of them.  This is the order in which -msave-restore saves
+   them.  */
+#define CALLEE_SAVED_REG_NUMBER(REGNO)				\
+  ((REGNO) >= 8 && (REGNO) <= 9 ? (REGNO) - 8 :				\
+   (REGNO) >= 18 && (REGNO) <= 27 ? (REGNO) - 16 : -1)
+
 #define FUNCTION_PROFILER(STREAM, LABELNO)	\
 {						\
     sorry ("profiler support for RISC-V");	\
@@ -1118,6 +1132,17 @@ while (0)
 
 #ifndef USED_FOR_TARGET
 
+/* The microarchitectures -mtune knows about.  These must be kept in the
+   same order as the values of the "tune" attribute in riscv.md.  */
+enum riscv_microarchitecture_type {
+  RISCV_UARCH_GENERIC,
+  RISCV_UARCH_ROCKET,
+  RISCV_UARCH_SIFIVE_7
+};
+
+extern enum riscv_microarchitecture_type riscv_microarchitecture;
+#define riscv_tune_attr ((enum attr_tune) riscv_microarchitecture)
+
 extern const enum reg_class riscv_regno_to_class[];
 extern bool riscv_hard_regno_mode_ok[][FIRST_PSEUDO_REGISTER];
 extern const char* riscv_hi_relocs[];
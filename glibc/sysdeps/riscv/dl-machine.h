@@ -39,6 +39,7 @@
 #define R_RISCV_TLS_DTPREL64  9
 #define R_RISCV_TLS_TPREL32  10
 #define R_RISCV_TLS_TPREL64  11
+#define R_RISCV_IRELATIVE    58
 
 #include <entry.h>
 
@@ -48,6 +49,7 @@
 
 #include <sys/asm.h>
 #include <dl-tls.h>
+#include <dl-irel.h>
 
 #ifndef _RTLD_PROLOGUE
 # define _RTLD_PROLOGUE(entry)						\
@@ -78,6 +80,10 @@
 #define ELF_MACHINE_NO_REL 1
 #define ELF_MACHINE_NO_RELA 0
 
+/* Apply R_RISCV_IRELATIVE relocs after all others, so that resolvers
+   see fully relocated objects.  */
+#define ELF_MACHINE_IRELATIVE R_RISCV_IRELATIVE
+
 /* Return nonzero iff ELF header is compatible with the running host.  */
 static inline int __attribute_used__
 elf_machine_matches_host (const ElfW(Ehdr) *ehdr)
@@ -180,7 +186,17 @@ elf_machine_rela (struct link_map *map, const ElfW(Rela) *reloc,
   struct link_map *sym_map = RESOLVE_MAP (&sym, version, r_type);
   ElfW(Addr) value = 0;
   if (sym_map != NULL)
-    value = sym_map->l_addr + sym->st_value + reloc->r_addend;
+    {
+      value = sym_map->l_addr + sym->st_value;
+      /* References to an STT_GNU_IFUNC symbol are bound to whatever
+	 its resolver returns.  */
+      if (sym != NULL
+	  && __glibc_unlikely (ELFW(ST_TYPE) (sym->st_info) == STT_GNU_IFUNC)
+	  && __glibc_likely (sym->st_shndx != SHN_UNDEF)
+	  && __glibc_likely (!skip_ifunc))
+	value = elf_ifunc_invoke (value);
+      value += reloc->r_addend;
+    }
 
   switch (r_type)
     {
@@ -262,6 +278,13 @@ elf_machine_rela (struct link_map *map, const ElfW(Rela) *reloc,
       *addr_field = value;
       break;
 
+    case R_RISCV_IRELATIVE:
+      value = map->l_addr + reloc->r_addend;
+      if (__glibc_likely (!skip_ifunc))
+	value = elf_ifunc_invoke (value);
+      *addr_field = value;
+      break;
+
     case R_RISCV_NONE:
       break;
 
@@ -298,6 +321,14 @@ elf_machine_lazy_rel (struct link_map *map, ElfW(Addr) l_addr,
       else
 	*reloc_addr = map->l_mach.plt;
     }
+  else if (__glibc_unlikely (r_type == R_RISCV_IRELATIVE))
+    {
+      /* Resolvers run eagerly; there is no lazy IFUNC binding.  */
+      ElfW(Addr) value = map->l_addr + reloc->r_addend;
+      if (__glibc_likely (!skip_ifunc))
+	value = elf_ifunc_invoke (value);
+      *reloc_addr = value;
+    }
   else
     _dl_reloc_bad_type (map, r_type, 1);
 }
@@ -310,8 +341,10 @@ __attribute__((always_inline))
 elf_machine_runtime_setup (struct link_map *l, int lazy, int profile)
 {
 #ifndef RTLD_BOOTSTRAP
-  /* If using PLTs, fill in the first two entries of .got.plt.  */
-  if (l->l_info[DT_JMPREL])
+  /* If binding lazily through PLTs, fill in the first two entries of
+     .got.plt.  Otherwise every slot is bound before the object runs, and
+     the PLT header and _dl_runtime_resolve are never reached.  */
+  if (l->l_info[DT_JMPREL] && lazy)
     {
       extern void _dl_runtime_resolve (void) __attribute__((visibility("hidden")));
       ElfW(Addr) *gotplt = (ElfW(Addr) *) D_PTR (l, l_info[DT_PLTGOT]);
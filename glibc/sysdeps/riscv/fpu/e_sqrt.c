@@ -0,0 +1,16 @@
+#include <math.h>
+#include <math_private.h>
+
+#ifdef __riscv_fsqrt
+
+double __ieee754_sqrt (double x)
+{
+  double res;
+  asm ("fsqrt.d %0, %1" : "=f"(res) : "f"(x));
+  return res;
+}
+strong_alias (__ieee754_sqrt, __sqrt_finite)
+
+#else
+#include <sysdeps/ieee754/dbl-64/e_sqrt.c>
+#endif
@@ -0,0 +1,16 @@
+#include <math.h>
+#include <math_private.h>
+
+#ifdef __riscv_fsqrt
+
+float __ieee754_sqrtf (float x)
+{
+  float res;
+  asm ("fsqrt.s %0, %1" : "=f"(res) : "f"(x));
+  return res;
+}
+strong_alias (__ieee754_sqrtf, __sqrtf_finite)
+
+#else
+#include <sysdeps/ieee754/flt-32/e_sqrtf.c>
+#endif
@@ -0,0 +1,37 @@
+#include <math.h>
+#include <math_private.h>
+#include "fpu_control.h"
+
+#ifdef __riscv64
+
+double __ceil (double x)
+{
+  int flags;
+  long int i;
+  double res;
+
+  if (__builtin_expect (isnan (x), 0))
+    return x + x;
+
+  /* Anything of magnitude 2^52 or more is already integral.  */
+  if (fabs (x) >= 0x1p52)
+    return x;
+
+  /* The conversion raises inexact, which ceil must not.  */
+  _FPU_GETFLAGS (flags);
+  asm volatile ("fcvt.l.d %0, %1, rup" : "=r"(i) : "f"(x));
+  asm volatile ("fcvt.d.l %0, %1" : "=f"(res) : "r"(i));
+  _FPU_SETFLAGS (flags);
+
+  /* Zero results keep the sign of X.  */
+  return copysign (res, x);
+}
+weak_alias (__ceil, ceil)
+#ifdef NO_LONG_DOUBLE
+strong_alias (__ceil, __ceill)
+weak_alias (__ceil, ceill)
+#endif
+
+#else
+#include <sysdeps/ieee754/dbl-64/s_ceil.c>
+#endif
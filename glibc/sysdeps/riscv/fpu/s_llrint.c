@@ -0,0 +1,19 @@
+#include <math.h>
+
+#ifdef __riscv64
+
+long long int __llrint (double x)
+{
+  long long int res;
+  asm volatile ("fcvt.l.d %0, %1, dyn" : "=r"(res) : "f"(x));
+  return res;
+}
+weak_alias (__llrint, llrint)
+#ifdef NO_LONG_DOUBLE
+strong_alias (__llrint, __llrintl)
+weak_alias (__llrint, llrintl)
+#endif
+
+#else
+#include <sysdeps/ieee754/dbl-64/s_llrint.c>
+#endif
@@ -0,0 +1,15 @@
+#include <math.h>
+
+#ifdef __riscv64
+
+long long int __llrintf (float x)
+{
+  long long int res;
+  asm volatile ("fcvt.l.s %0, %1, dyn" : "=r"(res) : "f"(x));
+  return res;
+}
+weak_alias (__llrintf, llrintf)
+
+#else
+#include <sysdeps/ieee754/flt-32/s_llrintf.c>
+#endif
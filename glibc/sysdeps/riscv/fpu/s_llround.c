@@ -0,0 +1,19 @@
+#include <math.h>
+
+#ifdef __riscv64
+
+long long int __llround (double x)
+{
+  long long int res;
+  asm ("fcvt.l.d %0, %1, rmm" : "=r"(res) : "f"(x));
+  return res;
+}
+weak_alias (__llround, llround)
+#ifdef NO_LONG_DOUBLE
+strong_alias (__llround, __llroundl)
+weak_alias (__llround, llroundl)
+#endif
+
+#else
+#include <sysdeps/ieee754/dbl-64/s_llround.c>
+#endif
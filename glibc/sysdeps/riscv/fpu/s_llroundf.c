@@ -0,0 +1,15 @@
+#include <math.h>
+
+#ifdef __riscv64
+
+long long int __llroundf (float x)
+{
+  long long int res;
+  asm ("fcvt.l.s %0, %1, rmm" : "=r"(res) : "f"(x));
+  return res;
+}
+weak_alias (__llroundf, llroundf)
+
+#else
+#include <sysdeps/ieee754/flt-32/s_llroundf.c>
+#endif
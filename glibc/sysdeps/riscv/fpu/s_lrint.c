@@ -0,0 +1,17 @@
+#include <math.h>
+
+long int __lrint (double x)
+{
+  long int res;
+#ifdef __riscv64
+  asm volatile ("fcvt.l.d %0, %1, dyn" : "=r"(res) : "f"(x));
+#else
+  asm volatile ("fcvt.w.d %0, %1, dyn" : "=r"(res) : "f"(x));
+#endif
+  return res;
+}
+weak_alias (__lrint, lrint)
+#ifdef NO_LONG_DOUBLE
+strong_alias (__lrint, __lrintl)
+weak_alias (__lrint, lrintl)
+#endif
@@ -0,0 +1,13 @@
+#include <math.h>
+
+long int __lrintf (float x)
+{
+  long int res;
+#ifdef __riscv64
+  asm volatile ("fcvt.l.s %0, %1, dyn" : "=r"(res) : "f"(x));
+#else
+  asm volatile ("fcvt.w.s %0, %1, dyn" : "=r"(res) : "f"(x));
+#endif
+  return res;
+}
+weak_alias (__lrintf, lrintf)
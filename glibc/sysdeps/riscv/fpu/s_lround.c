@@ -0,0 +1,17 @@
+#include <math.h>
+
+long int __lround (double x)
+{
+  long int res;
+#ifdef __riscv64
+  asm ("fcvt.l.d %0, %1, rmm" : "=r"(res) : "f"(x));
+#else
+  asm ("fcvt.w.d %0, %1, rmm" : "=r"(res) : "f"(x));
+#endif
+  return res;
+}
+weak_alias (__lround, lround)
+#ifdef NO_LONG_DOUBLE
+strong_alias (__lround, __lroundl)
+weak_alias (__lround, lroundl)
+#endif
@@ -0,0 +1,13 @@
+#include <math.h>
+
+long int __lroundf (float x)
+{
+  long int res;
+#ifdef __riscv64
+  asm ("fcvt.l.s %0, %1, rmm" : "=r"(res) : "f"(x));
+#else
+  asm ("fcvt.w.s %0, %1, rmm" : "=r"(res) : "f"(x));
+#endif
+  return res;
+}
+weak_alias (__lroundf, lroundf)
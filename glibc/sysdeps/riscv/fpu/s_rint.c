@@ -0,0 +1,33 @@
+#include <math.h>
+#include <math_private.h>
+#include "fpu_control.h"
+
+#ifdef __riscv64
+
+double __rint (double x)
+{
+  long int i;
+  double res;
+
+  if (__builtin_expect (isnan (x), 0))
+    return x + x;
+
+  /* Anything of magnitude 2^52 or more is already integral.  */
+  if (fabs (x) >= 0x1p52)
+    return x;
+
+  asm volatile ("fcvt.l.d %0, %1, dyn" : "=r"(i) : "f"(x));
+  asm volatile ("fcvt.d.l %0, %1" : "=f"(res) : "r"(i));
+
+  /* Zero results keep the sign of X.  */
+  return copysign (res, x);
+}
+weak_alias (__rint, rint)
+#ifdef NO_LONG_DOUBLE
+strong_alias (__rint, __rintl)
+weak_alias (__rint, rintl)
+#endif
+
+#else
+#include <sysdeps/ieee754/dbl-64/s_rint.c>
+#endif
@@ -0,0 +1,23 @@
+#include <math.h>
+#include <math_private.h>
+#include "fpu_control.h"
+
+float __rintf (float x)
+{
+  int i;
+  float res;
+
+  if (__builtin_expect (isnan (x), 0))
+    return x + x;
+
+  /* Anything of magnitude 2^23 or more is already integral.  */
+  if (fabsf (x) >= 0x1p23f)
+    return x;
+
+  asm volatile ("fcvt.w.s %0, %1, dyn" : "=r"(i) : "f"(x));
+  asm volatile ("fcvt.s.w %0, %1" : "=f"(res) : "r"(i));
+
+  /* Zero results keep the sign of X.  */
+  return copysignf (res, x);
+}
+weak_alias (__rintf, rintf)
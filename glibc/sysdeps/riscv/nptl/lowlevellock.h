@@ -145,8 +145,11 @@
     atomic_compare_and_exchange_val_acq (&(futex), id, 0) != 0;               \
   })
 
+/* The slow paths in lowlevellock.c spin for a bounded time, set by
+   GLIBC_LLL_SPIN_COUNT in the environment, before sleeping.  */
 extern void __lll_lock_wait_private (int *futex) attribute_hidden;
 extern void __lll_lock_wait (int *futex, int private) attribute_hidden;
+extern void __lll_cond_lock_wait (int *futex, int private) attribute_hidden;
 extern int __lll_robust_lock_wait (int *futex, int private) attribute_hidden;
 
 #define lll_lock(futex, private) \
@@ -175,7 +178,7 @@ extern int __lll_robust_lock_wait (int *futex, int private) attribute_hidden;
     int val = atomic_compare_and_exchange_val_acq (&(futex), 2, 0);           \
                                                                               \
     if (__builtin_expect (val != 0, 0))                                       \
-      __lll_lock_wait (&(futex), private);                                    \
+      __lll_cond_lock_wait (&(futex), private);                               \
   })
 
 #define lll_robust_cond_lock(futex, id, private) \
@@ -16,23 +16,31 @@
    Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
    02111-1307 USA.  */
 
-#include <errno.h>
+#include "pthreadP.h"
+#include <atomic.h>
 
 int pthread_spin_lock(pthread_spinlock_t* lock)
 {
 #ifdef __riscv_atomic
-  int tmp1, tmp2;
-
-  asm volatile ("\n\
-  1:lw           %0, 0(%2)\n\
-    li           %1, %3\n\
-    bnez         %0, 1b\n\
-    amoswap.w.aq %0, %1, 0(%2)\n\
-    bnez         %0, 1b"
-    : "=&r"(tmp1), "=&r"(tmp2) : "r"(lock), "i"(EBUSY)
-  );
-
-  return tmp1;
+  unsigned int val = asm_amo("amoadd", ".aq", lock, 1 << SPIN_TICKET_SHIFT);
+  unsigned int ticket = val >> SPIN_TICKET_SHIFT;
+
+  if (__builtin_expect((val & SPIN_TICKET_MASK) == ticket, 1))
+    return 0;
+
+  /* Wait our turn.  Back off in proportion to the number of threads
+     queued ahead of us, so that waiters don't all reload the lock
+     word every time it changes hands.  */
+  do
+  {
+    unsigned int delay = (ticket - val) & SPIN_TICKET_MASK;
+    for (delay *= SPIN_TICKET_DELAY; delay > 0; delay--)
+      asm volatile ("");
+    val = *lock;
+  } while ((val & SPIN_TICKET_MASK) != ticket);
+
+  atomic_read_barrier();
+  return 0;
 #else
   return pthread_mutex_lock(lock);
 #endif
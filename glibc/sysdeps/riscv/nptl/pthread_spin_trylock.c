@@ -16,23 +16,25 @@
    Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
    02111-1307 USA.  */
 
+#include "pthreadP.h"
 #include <errno.h>
+#include <atomic.h>
 
 int pthread_spin_trylock(pthread_spinlock_t* lock)
 {
 #ifdef __riscv_atomic
-  int tmp1, tmp2;
-
-  asm volatile ("\n\
-    lw           %0, 0(%2)\n\
-    li           %1, %3\n\
-    bnez         %0, 1f\n\
-    amoswap.w.aq %0, %1, 0(%2)\n\
-  1:"
-    : "=&r"(tmp1), "=&r"(tmp2) : "r"(lock), "i"(EBUSY)
-  );
-
-  return tmp1;
+  unsigned int val = *lock;
+
+  /* Only take a ticket if it would be served immediately.  */
+  if ((val & SPIN_TICKET_MASK) != val >> SPIN_TICKET_SHIFT)
+    return EBUSY;
+
+  if (atomic_compare_and_exchange_bool_acq(lock,
+					   val + (1 << SPIN_TICKET_SHIFT),
+					   val))
+    return EBUSY;
+
+  return 0;
 #else
   return pthread_mutex_trylock(lock);
 #endif
@@ -25,7 +25,13 @@ int
 pthread_spin_unlock (pthread_spinlock_t *lock)
 {
 #ifdef __riscv_atomic
-  asm volatile ("amoswap.w.rl x0, x0, 0(%0)" : : "r"(lock));
+  /* Only the holder writes the low halfword, so serve the next ticket
+     with a plain store; an add could carry into the high halfword.  */
+  typedef volatile unsigned short __attribute__ ((may_alias)) ticket_t;
+  ticket_t *serving = (ticket_t *) lock;
+
+  atomic_write_barrier ();
+  *serving = *serving + 1;
   return 0;
 #else
   return pthread_mutex_unlock(lock);
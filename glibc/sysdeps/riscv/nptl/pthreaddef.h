@@ -30,3 +30,12 @@
 
 /* Location of current stack frame.  */
 #define CURRENT_STACK_FRAME	__builtin_frame_address (0)
+
+/* With the A extension, a pthread_spinlock_t is a ticket lock: the low
+   halfword holds the ticket now being served, and the high halfword
+   the next ticket to hand out.  Both wrap independently.  */
+#define SPIN_TICKET_SHIFT	16
+#define SPIN_TICKET_MASK	0xffff
+
+/* Iterations a waiter backs off for, per thread queued ahead of it.  */
+#define SPIN_TICKET_DELAY	32
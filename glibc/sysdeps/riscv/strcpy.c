@@ -7,39 +7,47 @@ char* strcpy(char* dst, const char* src)
 {
   char* dst0 = dst;
 
-  int misaligned = ((uintptr_t)dst | (uintptr_t)src) & (sizeof(long)-1);
-  if (__builtin_expect(!misaligned, 1))
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  /* Align dst, then store whole words until the word about to be
+     stored would contain the terminator. */
+  while ((uintptr_t)dst & (sizeof(long)-1))
+    if (!(*dst++ = *src++))
+      return dst0;
+
+  unsigned long* ldst = (unsigned long*)dst;
+  uintptr_t misalign = (uintptr_t)src & (sizeof(long)-1);
+
+  if (__builtin_expect(!misalign, 1))
   {
-    long* ldst = (long*)dst;
-    const long* lsrc = (const long*)src;
+    const unsigned long* lsrc = (const unsigned long*)src;
 
     while (!__libc_detect_null(*lsrc))
       *ldst++ = *lsrc++;
+  }
+  else
+  {
+    /* Each dst word straddles two aligned src words.  Only load the
+       second once the first is known to hold no terminator. */
+    unsigned shr = 8*misalign, shl = 8*sizeof(long) - shr;
+    const unsigned long* lsrc = (const unsigned long*)(src - misalign);
+    unsigned long lo = *lsrc;
 
-    dst = (char*)ldst;
-    src = (const char*)lsrc;
-
-    char c0 = src[0];
-    char c1 = src[1];
-    char c2 = src[2];
-    if (!(*dst++ = c0)) return dst0;
-    if (!(*dst++ = c1)) return dst0;
-    char c3 = src[3];
-    if (!(*dst++ = c2)) return dst0;
-    if (sizeof(long) == 4) goto out;
-    char c4 = src[4];
-    if (!(*dst++ = c3)) return dst0;
-    char c5 = src[5];
-    if (!(*dst++ = c4)) return dst0;
-    char c6 = src[6];
-    if (!(*dst++ = c5)) return dst0;
-    if (!(*dst++ = c6)) return dst0;
-
-out:
-    *dst++ = 0;
-    return dst0;
+    while (!__libc_detect_null(lo | ((1UL << shr) - 1)))
+    {
+      unsigned long hi = *++lsrc;
+      unsigned long w = (lo >> shr) | (hi << shl);
+      if (__libc_detect_null(w))
+        break;
+      *ldst++ = w;
+      lo = hi;
+    }
   }
 
+  size_t copied = (char*)ldst - dst;
+  dst += copied;
+  src += copied;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
   char ch;
   do
   {
@@ -51,4 +59,6 @@ out:
 
   return dst0;
 }
+#ifdef libc_hidden_def
 libc_hidden_def(strcpy)
+#endif
@@ -0,0 +1,45 @@
+#include <string.h>
+#include <stdint.h>
+
+#undef strnlen
+
+#ifdef libc_hidden_def
+# define STRNLEN __strnlen
+#else
+# define STRNLEN strnlen
+#endif
+
+size_t STRNLEN(const char* str, size_t n)
+{
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+  size_t len = 0;
+  while (len < n && str[len])
+    len++;
+  return len;
+#else
+  if (__builtin_expect(n == 0, 0))
+    return 0;
+
+  /* As in strlen, but only load another word while part of it still
+     lies within the first n bytes. */
+  uintptr_t misalign = (uintptr_t)str & (sizeof(long)-1);
+  const unsigned long* ls = (const unsigned long*)(str - misalign);
+  unsigned long null = __libc_detect_null(*ls | ((1UL << (8*misalign)) - 1));
+  size_t seen = sizeof(long) - misalign;
+
+  while (!null)
+  {
+    if (seen >= n)
+      return n;
+    null = __libc_detect_null(*++ls);
+    seen += sizeof(long);
+  }
+
+  size_t len = (const char*)ls + __libc_first_null(null) - str;
+  return len < n ? len : n;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+}
+#ifdef libc_hidden_def
+weak_alias(__strnlen, strnlen)
+libc_hidden_def(strnlen)
+#endif
@@ -0,0 +1,35 @@
+/* Defines for bits in AT_HWCAP.  RISC-V Linux version.
+   Copyright (C) 2014 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, write to the Free
+   Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307 USA.  */
+
+#if !defined (_SYS_AUXV_H) && !defined (_LINUX_RISCV_SYSDEP_H)
+# error "Never include <bits/hwcap.h> directly; use <sys/auxv.h> instead."
+#endif
+
+/* The kernel reports one bit per single-letter ISA extension, with
+   bit N set if extension 'A' + N is present.  These are also the
+   argument passed to IFUNC resolvers.  */
+#define HWCAP_RISCV_ISA(letter)	(1UL << ((letter) - 'A'))
+
+#define HWCAP_RISCV_A		HWCAP_RISCV_ISA ('A')
+#define HWCAP_RISCV_C		HWCAP_RISCV_ISA ('C')
+#define HWCAP_RISCV_D		HWCAP_RISCV_ISA ('D')
+#define HWCAP_RISCV_F		HWCAP_RISCV_ISA ('F')
+#define HWCAP_RISCV_I		HWCAP_RISCV_ISA ('I')
+#define HWCAP_RISCV_M		HWCAP_RISCV_ISA ('M')
+#define HWCAP_RISCV_X		HWCAP_RISCV_ISA ('X')
@@ -0,0 +1,34 @@
+/* Resolve function pointers to vDSO functions.  RISC-V version.
+   Copyright (C) 2014 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library.  If not, see
+   <http://www.gnu.org/licenses/>.  */
+
+#ifndef _LIBC_VDSO_H
+#define _LIBC_VDSO_H
+
+#ifdef SHARED
+
+/* Set up by __libc_init_first; NULL if the kernel provides no vDSO or
+   the vDSO lacks the function.  Each follows the system call's calling
+   convention, returning a negated errno value on failure.  */
+extern void *__vdso_clock_gettime attribute_hidden;
+extern void *__vdso_clock_getres attribute_hidden;
+extern void *__vdso_gettimeofday attribute_hidden;
+extern void *__vdso_getcpu attribute_hidden;
+
+#endif
+
+#endif /* _LIBC_VDSO_H */
@@ -0,0 +1,50 @@
+/* Initialization code run first thing by the ELF startup code.  RISC-V version.
+   Copyright (C) 2014 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library.  If not, see
+   <http://www.gnu.org/licenses/>.  */
+
+#ifdef SHARED
+# include <dl-vdso.h>
+# include <bits/libc-vdso.h>
+
+void *__vdso_clock_gettime attribute_hidden;
+void *__vdso_clock_getres attribute_hidden;
+void *__vdso_gettimeofday attribute_hidden;
+void *__vdso_getcpu attribute_hidden;
+
+static inline void *
+__vdso_lookup (const char *name, const struct r_found_version *vers)
+{
+  void *p = _dl_vdso_vsym (name, vers);
+  PTR_MANGLE (p);
+  return p;
+}
+
+static inline void
+_libc_vdso_platform_setup (void)
+{
+  PREPARE_VERSION (linux415, "LINUX_4.15", 182943605);
+
+  __vdso_clock_gettime = __vdso_lookup ("__vdso_clock_gettime", &linux415);
+  __vdso_clock_getres = __vdso_lookup ("__vdso_clock_getres", &linux415);
+  __vdso_gettimeofday = __vdso_lookup ("__vdso_gettimeofday", &linux415);
+  __vdso_getcpu = __vdso_lookup ("__vdso_getcpu", &linux415);
+}
+
+# define VDSO_SETUP _libc_vdso_platform_setup
+#endif
+
+#include <csu/init-first.c>
@@ -0,0 +1,214 @@
+/* Low-level lock slow paths.  RISC-V version.
+   Copyright (C) 2003-2015 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, write to the Free
+   Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307 USA.  */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sysdep.h>
+#include <lowlevellock.h>
+#include <sys/time.h>
+#include <atomic.h>
+
+/* These slow paths spin for a while before sleeping in the kernel, since
+   most critical sections are much shorter than a FUTEX_WAIT round trip.
+   The number of polls can be set with GLIBC_LLL_SPIN_COUNT in the
+   environment; 0 disables spinning.  */
+
+#define LLL_SPIN_COUNT_DEFAULT	100
+#define LLL_SPIN_COUNT_MAX	100000
+#define LLL_SPIN_COUNT_ENV	"GLIBC_LLL_SPIN_COUNT="
+
+static int lll_spin_count = -1;
+
+/* Read the spin count from the environment.  This runs the first time a
+   lock is contended, possibly with other locks held, so it can't call
+   getenv, which takes the environment lock.  */
+
+static int
+lll_read_spin_count (void)
+{
+  size_t len = sizeof (LLL_SPIN_COUNT_ENV) - 1;
+  int count = LLL_SPIN_COUNT_DEFAULT;
+  char **ep;
+
+  for (ep = __environ; ep != NULL && *ep != NULL; ep++)
+    if (strncmp (*ep, LLL_SPIN_COUNT_ENV, len) == 0)
+      {
+	const char *s = *ep + len;
+
+	for (count = 0; *s >= '0' && *s <= '9'; s++)
+	  if (count < LLL_SPIN_COUNT_MAX)
+	    count = count * 10 + (*s - '0');
+	if (count > LLL_SPIN_COUNT_MAX)
+	  count = LLL_SPIN_COUNT_MAX;
+	break;
+      }
+
+  lll_spin_count = count;
+  return count;
+}
+
+/* Wait for *FUTEX to become free, polling it with plain loads so that
+   its cache line stays shared while the owner runs, and try to take it
+   by setting it to NEWVAL.  Return true on success.  Polling with lr.w
+   instead would request the line for writing on every iteration.  */
+
+static inline int
+lll_spin_trylock (int *futex, int newval)
+{
+  int count = lll_spin_count;
+
+  if (__builtin_expect (count < 0, 0))
+    count = lll_read_spin_count ();
+
+  while (count-- > 0)
+    {
+      if (*(volatile int *) futex == 0
+	  && atomic_compare_and_exchange_bool_acq (futex, newval, 0) == 0)
+	return 1;
+      asm volatile ("" ::: "memory");
+    }
+
+  return 0;
+}
+
+void
+__lll_lock_wait_private (int *futex)
+{
+  if (lll_spin_trylock (futex, 1))
+    return;
+
+  if (*futex == 2)
+    lll_futex_wait (futex, 2, LLL_PRIVATE);
+
+  while (atomic_exchange_acq (futex, 2) != 0)
+    lll_futex_wait (futex, 2, LLL_PRIVATE);
+}
+
+
+/* These functions don't get included in libc.so  */
+#ifdef IS_IN_libpthread
+void
+__lll_lock_wait (int *futex, int private)
+{
+  if (lll_spin_trylock (futex, 1))
+    return;
+
+  if (*futex == 2)
+    lll_futex_wait (futex, 2, private);
+
+  while (atomic_exchange_acq (futex, 2) != 0)
+    lll_futex_wait (futex, 2, private);
+}
+
+
+/* Likewise for lll_cond_lock, which must leave the lock marked as
+   contended: waiters requeued from a condition variable may be asleep
+   on it without having set it to 2 themselves.  */
+
+void
+__lll_cond_lock_wait (int *futex, int private)
+{
+  if (lll_spin_trylock (futex, 2))
+    return;
+
+  while (atomic_exchange_acq (futex, 2) != 0)
+    lll_futex_wait (futex, 2, private);
+}
+
+
+int
+__lll_timedlock_wait (int *futex, const struct timespec *abstime, int private)
+{
+  /* Reject invalid timeouts.  */
+  if (abstime->tv_nsec < 0 || abstime->tv_nsec >= 1000000000)
+    return EINVAL;
+
+  if (lll_spin_trylock (futex, 1))
+    return 0;
+
+  /* Try locking.  */
+  while (atomic_exchange_acq (futex, 2) != 0)
+    {
+      struct timeval tv;
+
+      /* Get the current time.  */
+      (void) __gettimeofday (&tv, NULL);
+
+      /* Compute relative timeout.  */
+      struct timespec rt;
+      rt.tv_sec = abstime->tv_sec - tv.tv_sec;
+      rt.tv_nsec = abstime->tv_nsec - tv.tv_usec * 1000;
+      if (rt.tv_nsec < 0)
+	{
+	  rt.tv_nsec += 1000000000;
+	  --rt.tv_sec;
+	}
+
+      if (rt.tv_sec < 0)
+	return ETIMEDOUT;
+
+      /* If *futex == 2, wait until woken or timeout.  */
+      lll_futex_timed_wait (futex, 2, &rt, private);
+    }
+
+  return 0;
+}
+
+
+int
+__lll_timedwait_tid (int *tidp, const struct timespec *abstime)
+{
+  int tid;
+
+  if (abstime->tv_nsec < 0 || abstime->tv_nsec >= 1000000000)
+    return EINVAL;
+
+  /* Repeat until thread terminated.  */
+  while ((tid = *tidp) != 0)
+    {
+      struct timeval tv;
+      struct timespec rt;
+
+      /* Get the current time.  */
+      (void) __gettimeofday (&tv, NULL);
+
+      /* Compute relative timeout.  */
+      rt.tv_sec = abstime->tv_sec - tv.tv_sec;
+      rt.tv_nsec = abstime->tv_nsec - tv.tv_usec * 1000;
+      if (rt.tv_nsec < 0)
+	{
+	  rt.tv_nsec += 1000000000;
+	  --rt.tv_sec;
+	}
+
+      /* Already timed out?  */
+      if (rt.tv_sec < 0)
+	return ETIMEDOUT;
+
+      /* Wait until thread terminates.  The kernel so far does not use
+	 the private futex operations for this.  */
+      if (lll_futex_timed_wait (tidp, tid, &rt, LLL_SHARED) == -ETIMEDOUT)
+	return ETIMEDOUT;
+    }
+
+  return 0;
+}
+#endif
@@ -64,4 +64,22 @@ typedef struct ucontext
     __sigset_t uc_sigmask;
   } ucontext_t;
 
+#ifdef __USE_GNU
+/* Set in uc_flags if the context doesn't use the FP registers, so that
+   __riscv_swapcontext_fast needn't save or restore them.  getcontext
+   and swapcontext clear uc_flags, so set this afterwards.  */
+# define UC_RISCV_NO_FP	1
+
+__BEGIN_DECLS
+
+/* Like swapcontext, but leave the signal mask unchanged instead of
+   making a system call to set it.  __OUCP's uc_sigmask and uc_flags
+   are left as they are, so it must have been initialized by getcontext
+   or swapcontext first.  */
+extern int __riscv_swapcontext_fast (ucontext_t *__oucp,
+				     const ucontext_t *__ucp) __THROWNL;
+
+__END_DECLS
+#endif
+
 #endif /* sys/ucontext.h */
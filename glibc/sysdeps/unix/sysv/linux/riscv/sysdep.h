@@ -250,6 +250,44 @@ L(syse1):
 })
 
 #define __SYSCALL_CLOBBERS "memory"
+
+/* Call the vDSO's version of a system call if the kernel provided one,
+   falling back to the system call itself if not, or if the vDSO
+   returns -ENOSYS.  Only libc.so sees the vDSO pointers.  */
+#if defined SHARED && !defined NOT_IN_libc
+# include <bits/libc-vdso.h>
+
+# define INLINE_VSYSCALL(name, nr, args...)				\
+  ({ INTERNAL_SYSCALL_DECL(err);					\
+     long result_var = INTERNAL_VSYSCALL (name, err, nr, args);	\
+     if (result_var < 0)						\
+       {								\
+	 extern long __syscall_error (long) attribute_hidden;		\
+	 result_var = __syscall_error (result_var);			\
+       }								\
+     result_var; })
+
+# define INTERNAL_VSYSCALL(name, err, nr, args...)			\
+  ({ long (*__vdsop) () = __vdso_##name;				\
+     long __v_ret = -ENOSYS;						\
+     PTR_DEMANGLE (__vdsop);						\
+     if (__vdsop != NULL)						\
+       __v_ret = __vdsop (args);					\
+     if (__v_ret == -ENOSYS)						\
+       __v_ret = INTERNAL_SYSCALL (name, err, nr, args);		\
+     __v_ret; })
+#else
+# define INLINE_VSYSCALL(name, nr, args...) \
+	INLINE_SYSCALL (name, nr, args)
+# define INTERNAL_VSYSCALL(name, err, nr, args...) \
+	INTERNAL_SYSCALL (name, err, nr, args)
+#endif
+
+/* System calls the vDSO may provide.  */
+#define HAVE_CLOCK_GETRES_VSYSCALL	1
+#define HAVE_CLOCK_GETTIME_VSYSCALL	1
+#define HAVE_GETTIMEOFDAY_VSYSCALL	1
+#define HAVE_GETCPU_VSYSCALL		1
 #endif /* ! __ASSEMBLER__ */
 
 /* Pointer mangling is not supported.  */
@@ -1,4 +1,28 @@
 #include <machine/bthread.h>
+#include <stdlib.h>
 
 __bthread_key_data_t __bthread_keys[__BTHREAD_KEYS_MAX];
-void* __bthread_key_data[__BTHREAD_THREADS_MAX][__BTHREAD_KEYS_MAX];
+__thread void* __bthread_key_data[__BTHREAD_KEYS_PER_BLOCK];
+__thread void** __bthread_key_blocks[__BTHREAD_KEY_BLOCKS];
+
+// Set a key outside the first block, allocating the calling thread's
+// block for it if need be.
+int __bthread_setspecific_block(unsigned int key, void* ptr)
+{
+  void*** block = &__bthread_key_blocks[key / __BTHREAD_KEYS_PER_BLOCK];
+
+  if(!*block)
+  {
+    // Keys in a missing block already read as null.
+    if(!ptr)
+      return 0;
+
+    *block = calloc(__BTHREAD_KEYS_PER_BLOCK, sizeof(void*));
+    if(!*block)
+      return ENOMEM;
+  }
+
+  (*block)[key % __BTHREAD_KEYS_PER_BLOCK] = ptr;
+
+  return 0;
+}
@@ -0,0 +1,24 @@
+#include <machine/bthread.h>
+#include <string.h>
+
+// The TLS image, as laid out by riscv.ld.  These are weak so that
+// programs linked with other scripts still link, with an empty block.
+extern char _tdata_begin[] __attribute__((weak));
+extern char _tdata_end[] __attribute__((weak));
+extern char _tbss_end[] __attribute__((weak));
+
+size_t __bthread_tls_size(void)
+{
+  return _tbss_end - _tdata_begin;
+}
+
+void __bthread_tls_init(void* block)
+{
+  size_t data_size = _tdata_end - _tdata_begin;
+
+  memcpy(block, _tdata_begin, data_size);
+  memset((char*)block + data_size, 0, __bthread_tls_size() - data_size);
+
+  // tp-relative offsets are measured from the start of the image.
+  __asm__ __volatile__ ("mv tp, %0" : : "r"(block) : "memory");
+}
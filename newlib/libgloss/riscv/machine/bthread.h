@@ -4,19 +4,38 @@
 #define __GTHREADS 1
 
 #include <errno.h>
+#include <stddef.h>
 
 #define __BTHREAD_MUTEX_INIT { 0 }
-#define __BTHREAD_ONCE_INIT  { __BTHREAD_MUTEX_INIT }
-#define __BTHREAD_KEYS_MAX 128
-#define __BTHREAD_THREADS_MAX 128
+#define __BTHREAD_ONCE_INIT  { __BTHREAD_MUTEX_INIT, 0 }
+#define __BTHREAD_KEYS_MAX 1024
+
+// Each thread keeps the values of the first block of keys in its TLS
+// block; the values of the other keys go in blocks that are allocated
+// the first time one of their keys is set.
+#define __BTHREAD_KEYS_PER_BLOCK 32
+#define __BTHREAD_KEY_BLOCKS (__BTHREAD_KEYS_MAX / __BTHREAD_KEYS_PER_BLOCK)
+
+// Number of idle iterations a waiter spins for each thread ahead of it
+// in a mutex's queue before polling the mutex again.
+#define __BTHREAD_MUTEX_BACKOFF 16
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef struct
+// A ticket lock.  Threads take a ticket by atomically incrementing
+// next and enter once owner reaches their ticket, so the mutex is
+// granted in FIFO order.  Both halves share one word so that trylock
+// can claim a ticket with a single compare-and-swap.
+typedef union
 {
   unsigned int lock;
+  struct
+  {
+    unsigned short owner;
+    unsigned short next;
+  } ticket;
 } __bthread_mutex_t;
 
 typedef struct
@@ -26,10 +45,11 @@ typedef struct
 } __bthread_key_data_t;
 
 extern __bthread_key_data_t __bthread_keys[__BTHREAD_KEYS_MAX];
-// should use TLS for this!
-extern void* __bthread_key_data[__BTHREAD_THREADS_MAX][__BTHREAD_KEYS_MAX];
+extern __thread void* __bthread_key_data[__BTHREAD_KEYS_PER_BLOCK];
+// Entry 0 is unused, since the first block is __bthread_key_data.
+extern __thread void** __bthread_key_blocks[__BTHREAD_KEY_BLOCKS];
 
-typedef unsigned int __bthread_t;
+typedef unsigned long __bthread_t;
 
 typedef struct
 {
@@ -38,17 +58,29 @@ typedef struct
 
 typedef struct {
   __bthread_mutex_t once;
+  int done;
 } __bthread_once_t;
 
+// Return the size of a thread's TLS block.
+extern size_t __bthread_tls_size(void);
+
+// Initialize the 16-byte aligned, __bthread_tls_size()-byte TLS block at
+// BLOCK from the .tdata/.tbss image and point tp at it.  crt0.S does
+// this for the initial thread; any other hart must do it before touching thread-local data.
+extern void __bthread_tls_init(void* block);
+
+extern int __bthread_setspecific_block(unsigned int key, void* ptr);
 
 static inline __bthread_t __bthread_self(void)
 {
-  // in the future, we should use TLS for this.
+  // tp points to the thread's TLS block, which is unique and never null.
   register __bthread_t __id asm("tp");
   return __id;
 }
 
-// returns true if there is more than 1 core in the system
+// Harts can start at any time, so locking is never elided: a mutex
+// must be taken and released the same way.  An uncontended lock is a
+// single AMO.
 static inline int __bthread_threading(void)
 {
   return 1;
@@ -62,28 +94,51 @@ static inline int __bthread_mutex_init(__bthread_mutex_t* lock)
 
 static inline int __bthread_mutex_trylock(__bthread_mutex_t* lock)
 {
-  return __sync_lock_test_and_set(&lock->lock, 1);
+  unsigned int old = __atomic_load_n(&lock->lock, __ATOMIC_RELAXED);
+
+  if ((unsigned short)(old >> 16) != (unsigned short)old)
+    return EBUSY;
+
+  if (!__atomic_compare_exchange_n(&lock->lock, &old, old + (1U << 16), 0,
+                                   __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    return EBUSY;
+
+  return 0;
 }
 
 static inline int __bthread_mutex_locked(__bthread_mutex_t* lock)
 {
-  return lock->lock;
+  unsigned int word = __atomic_load_n(&lock->lock, __ATOMIC_RELAXED);
+  return (unsigned short)(word >> 16) != (unsigned short)word;
 }
 
 static inline int __bthread_mutex_lock(__bthread_mutex_t* lock)
 {
-  do
+  unsigned int old = __atomic_fetch_add(&lock->lock, 1U << 16,
+                                        __ATOMIC_ACQUIRE);
+  unsigned short ticket = old >> 16;
+  unsigned short owner = old;
+
+  while (owner != ticket)
   {
-    while(__bthread_mutex_locked(lock));
+    // Back off in proportion to our place in the queue, so that the
+    // waiters do not all poll the lock's line on every release.
+    unsigned int spins = (unsigned short)(ticket - owner)
+                         * __BTHREAD_MUTEX_BACKOFF;
+    while (spins--)
+      __asm__ __volatile__ ("" ::: "memory");
+
+    owner = __atomic_load_n(&lock->ticket.owner, __ATOMIC_ACQUIRE);
   }
-  while(__bthread_mutex_trylock(lock));
 
   return 0;
 }
 
 static inline int __bthread_mutex_unlock(__bthread_mutex_t* lock)
 {
-  lock->lock = 0;
+  __atomic_store_n(&lock->ticket.owner,
+                   (unsigned short)(lock->ticket.owner + 1),
+                   __ATOMIC_RELEASE);
   return 0;
 }
 
@@ -93,15 +148,19 @@ __bthread_once (__bthread_once_t *__once, void (*__func) (void))
   if(!__once || !__func)
     return EINVAL;
 
-  if(__bthread_mutex_locked(&__once->once))
+  if(__atomic_load_n(&__once->done, __ATOMIC_ACQUIRE))
     return 0;
 
-  if(__bthread_mutex_trylock(&__once->once))
-    return 0;
-
-  (*__func)();
+  // Later callers wait here until the first one has finished __func.
+  __bthread_mutex_lock(&__once->once);
+  if(!__once->done)
+  {
+    (*__func)();
+    __atomic_store_n(&__once->done, 1, __ATOMIC_RELEASE);
+  }
+  __bthread_mutex_unlock(&__once->once);
 
-  return 0;  
+  return 0;
 }
 
 static inline int 
@@ -127,9 +186,6 @@ __bthread_key_create( __bthread_key_t* __key, void (*__dtor) (void*) )
 static inline int
 __bthread_key_valid( __bthread_key_t __key )
 {
-  if(__bthread_self() >= __BTHREAD_THREADS_MAX)
-    return 0;
-
   if(__key.key >= __BTHREAD_KEYS_MAX)
     return 0;
 
@@ -156,7 +212,10 @@ __bthread_setspecific( __bthread_key_t __key, void* __ptr )
   if(!__bthread_key_valid(__key))
     return EINVAL;
 
-  __bthread_key_data[__bthread_self()][__key.key] = __ptr;
+  if(__key.key >= __BTHREAD_KEYS_PER_BLOCK)
+    return __bthread_setspecific_block(__key.key, __ptr);
+
+  __bthread_key_data[__key.key] = __ptr;
 
   return 0;
 }
@@ -164,10 +223,19 @@ __bthread_setspecific( __bthread_key_t __key, void* __ptr )
 static inline void* 
 __bthread_getspecific( __bthread_key_t __key )
 {
+  void** block;
+
   if(!__bthread_key_valid(__key))
     return 0;
 
-  return (void*)__bthread_key_data[__bthread_self()][__key.key];
+  if(__key.key < __BTHREAD_KEYS_PER_BLOCK)
+    return __bthread_key_data[__key.key];
+
+  block = __bthread_key_blocks[__key.key / __BTHREAD_KEYS_PER_BLOCK];
+  if(!block)
+    return 0;
+
+  return block[__key.key % __BTHREAD_KEYS_PER_BLOCK];
 }
 
 #ifdef __cplusplus
@@ -225,10 +293,7 @@ __gthread_active_p (void)
 static inline int
 __gthread_once (__gthread_once_t *__once, void (*__func) (void))
 {
-  if (__gthread_active_p ())
-    return __gthrw_(__bthread_once) (__once, __func);
-  else
-    return -1;
+  return __gthrw_(__bthread_once) (__once, __func);
 }
 
 static inline int
@@ -292,7 +357,7 @@ static inline int
 __gthread_recursive_mutex_init_function (__gthread_recursive_mutex_t *__mutex)
 {
   __mutex->depth = 0;
-  __mutex->owner = __gthrw_(__bthread_self) ();
+  __mutex->owner = (__bthread_t) 0;
   __bthread_mutex_init(&__mutex->actual);
   return 0;
 }
@@ -300,37 +365,31 @@ __gthread_recursive_mutex_init_function (__gthread_recursive_mutex_t *__mutex)
 static inline int
 __gthread_recursive_mutex_lock (__gthread_recursive_mutex_t *__mutex)
 {
-  if (__gthread_active_p ())
-    {
-      __bthread_t __me = __gthrw_(__bthread_self) ();
+  __bthread_t __me = __gthrw_(__bthread_self) ();
 
-      if (__mutex->owner != __me)
-	{
-	  __gthrw_(__bthread_mutex_lock) (&__mutex->actual);
-	  __mutex->owner = __me;
-	}
-
-      __mutex->depth++;
+  if (__mutex->owner != __me)
+    {
+      __gthread_mutex_lock (&__mutex->actual);
+      __mutex->owner = __me;
     }
+
+  __mutex->depth++;
   return 0;
 }
 
 static inline int
 __gthread_recursive_mutex_trylock (__gthread_recursive_mutex_t *__mutex)
 {
-  if (__gthread_active_p ())
-    {
-      __bthread_t __me = __gthrw_(__bthread_self) ();
+  __bthread_t __me = __gthrw_(__bthread_self) ();
 
-      if (__mutex->owner != __me)
-	{
-	  if (__gthrw_(__bthread_mutex_trylock) (&__mutex->actual))
-	    return 1;
-	  __mutex->owner = __me;
-	}
-
-      __mutex->depth++;
+  if (__mutex->owner != __me)
+    {
+      if (__gthread_mutex_trylock (&__mutex->actual))
+	return 1;
+      __mutex->owner = __me;
     }
+
+  __mutex->depth++;
   return 0;
 }
 
@@ -339,13 +398,10 @@ __gthread_recursive_mutex_trylock (__gthread_recursive_mutex_t *__mutex)
 static inline int
 __gthread_recursive_mutex_unlock (__gthread_recursive_mutex_t *__mutex)
 {
-  if (__gthread_active_p ())
+  if (--__mutex->depth == 0)
     {
-      if (--__mutex->depth == 0)
-	  {
-	   __mutex->owner = (__bthread_t) 0;
-	   __gthrw_(__bthread_mutex_unlock) (&__mutex->actual);
-	  }
+      __mutex->owner = (__bthread_t) 0;
+      __gthread_mutex_unlock (&__mutex->actual);
     }
   return 0;
 }
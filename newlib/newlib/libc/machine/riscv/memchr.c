@@ -0,0 +1,49 @@
+#include <string.h>
+#include <stdint.h>
+
+#undef memchr
+
+#ifdef libc_hidden_def
+# define MEMCHR __memchr
+#else
+# define MEMCHR memchr
+#endif
+
+void* MEMCHR(const void* src, int c_in, size_t n)
+{
+  const unsigned char* s = (const unsigned char*)src;
+  unsigned char c = c_in;
+
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+  for (; n != 0; s++, n--)
+    if (*s == c)
+      return (void*)s;
+  return NULL;
+#else
+  if (__builtin_expect(n == 0, 0))
+    return NULL;
+
+  /* Search a word at a time for a byte that becomes zero once xored
+     with c; see strnlen for why the loads stay within bounds. */
+  unsigned long cc = __libc_repeat_byte(c);
+  uintptr_t misalign = (uintptr_t)s & (sizeof(long)-1);
+  const unsigned long* ls = (const unsigned long*)(s - misalign);
+  unsigned long match = __libc_detect_null((*ls ^ cc) | ((1UL << (8*misalign)) - 1));
+  size_t seen = sizeof(long) - misalign;
+
+  while (!match)
+  {
+    if (seen >= n)
+      return NULL;
+    match = __libc_detect_null(*++ls ^ cc);
+    seen += sizeof(long);
+  }
+
+  const unsigned char* p = (const unsigned char*)ls + __libc_first_null(match);
+  return (size_t)(p - s) < n ? (void*)p : NULL;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+}
+#ifdef libc_hidden_def
+weak_alias(__memchr, memchr)
+libc_hidden_builtin_def(memchr)
+#endif
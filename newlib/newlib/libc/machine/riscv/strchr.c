@@ -0,0 +1,45 @@
+#include <string.h>
+#include <stdint.h>
+
+#undef strchr
+
+char* strchr(const char* str, int c_in)
+{
+  unsigned char c = c_in;
+
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+  for (;; str++)
+  {
+    if (*(const unsigned char*)str == c)
+      return (char*)str;
+    if (!*str)
+      return NULL;
+  }
+#else
+  /* Look for c and the terminator together; a word holding c turns
+     into one holding a zero byte once xored with c in every byte. */
+  unsigned long cc = __libc_repeat_byte(c);
+  uintptr_t misalign = (uintptr_t)str & (sizeof(long)-1);
+  unsigned long pad = (1UL << (8*misalign)) - 1;
+  const unsigned long* ls = (const unsigned long*)(str - misalign);
+  unsigned long w = *ls;
+  unsigned long null = __libc_detect_null(w | pad);
+  unsigned long match = __libc_detect_null((w ^ cc) | pad);
+
+  while (!(null | match))
+  {
+    w = *++ls;
+    null = __libc_detect_null(w);
+    match = __libc_detect_null(w ^ cc);
+  }
+
+  unsigned long i = __libc_first_null(null | match);
+  if (match & (0x80UL << (8*i)))
+    return (char*)ls + i;
+  return NULL;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+}
+#ifdef libc_hidden_def
+weak_alias(strchr, index)
+libc_hidden_builtin_def(strchr)
+#endif
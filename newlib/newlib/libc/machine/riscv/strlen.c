@@ -1,41 +1,28 @@
 #include <string.h>
 #include <stdint.h>
 
+#undef strlen
+
 size_t strlen(const char* str)
 {
-  const char* start = str;
-
 #if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+  const char* start = str;
   while (*str++)
     ;
   return str - start - 1;
 #else
-  if (__builtin_expect((uintptr_t)str & (sizeof(long)-1), 0)) do
-  {
-    char ch = *str;
-    str++;
-    if (!ch)
-      return str - start - 1;
-  } while ((uintptr_t)str & (sizeof(long)-1));
-
-  unsigned long* ls = (unsigned long*)str;
-  while (!__libc_detect_null(*ls++))
-    ;
-  asm volatile ("" : "+r"(ls)); /* prevent "optimization" */
-
-  str = (const char*)ls;
-  size_t ret = str - start, sl = sizeof(long);
+  /* Start from the aligned word holding str, with the bytes before
+     str forced nonzero.  It lies in the same page, so can't fault. */
+  uintptr_t misalign = (uintptr_t)str & (sizeof(long)-1);
+  const unsigned long* ls = (const unsigned long*)(str - misalign);
+  unsigned long null = __libc_detect_null(*ls | ((1UL << (8*misalign)) - 1));
 
-  char c0 = str[0-sl], c1 = str[1-sl], c2 = str[2-sl], c3 = str[3-sl];
-  if (c0 == 0)            return ret + 0 - sl;
-  if (c1 == 0)            return ret + 1 - sl;
-  if (c2 == 0)            return ret + 2 - sl;
-  if (sl == 4 || c3 == 0) return ret + 3 - sl;
+  while (!null)
+    null = __libc_detect_null(*++ls);
 
-  c0 = str[4-sl], c1 = str[5-sl], c2 = str[6-sl], c3 = str[7-sl];
-  if (c0 == 0)            return ret + 4 - sl;
-  if (c1 == 0)            return ret + 5 - sl;
-  if (c2 == 0)            return ret + 6 - sl;
-                          return ret + 7 - sl;
+  return (const char*)ls + __libc_first_null(null) - str;
 #endif /* not PREFER_SIZE_OVER_SPEED */
 }
+#ifdef libc_hidden_def
+libc_hidden_def(strlen)
+#endif
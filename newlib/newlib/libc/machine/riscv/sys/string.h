@@ -9,4 +9,29 @@ static inline unsigned long __libc_detect_null(unsigned long w)
   return ~(((w & mask) + mask) | w | mask);
 }
 
+/* Given a nonzero __libc_detect_null result, return the index of the
+   first (lowest-addressed) zero byte.  */
+static inline unsigned long __libc_first_null(unsigned long mask)
+{
+  unsigned long i = 0;
+  if (sizeof(long) == 8 && !(mask & 0xffffffff))
+    mask = (mask >> 16) >> 16, i += 4;
+  if (!(mask & 0xffff))
+    mask >>= 16, i += 2;
+  if (!(mask & 0xff))
+    i += 1;
+  return i;
+}
+
+/* Replicate byte c into every byte of a word.  */
+static inline unsigned long __libc_repeat_byte(unsigned char c)
+{
+  unsigned long w = c;
+  w |= w << 8;
+  w |= w << 16;
+  if (sizeof(long) == 8)
+    w |= (w << 16) << 16;
+  return w;
+}
+
 #endif